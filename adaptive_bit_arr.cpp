@@ -0,0 +1,466 @@
+#include "adaptive_bit_arr.hpp"
+#include <algorithm>
+#include <iterator>
+
+namespace
+{
+    // Индекс в разреженном режиме занимает 16 бит в списке своего блока, но
+    // плотный массив проще и быстрее на массовых операциях, поэтому список держим,
+    // пока единиц меньше size / 32. Обратно в список переходим только при вдвое
+    // меньшей плотности.
+    const int DENSE_DIVISOR = 32;
+    const int SPARSE_DIVISOR = 64;
+    const int VALUE_BITS = static_cast<int>(sizeof(unsigned long) * 8);
+
+    // Список одного блока не длиннее 2^16, поэтому вставка стоит не больше
+    // сдвига 128 КБ независимо от размера массива.
+    const int BLOCK_SHIFT = 16;
+    const int BLOCK_MASK = (1 << BLOCK_SHIFT) - 1;
+
+    using Block = std::vector<uint16_t>;
+
+    int block_count(int size_bits)
+    {
+        return static_cast<int>((static_cast<int64_t>(size_bits) + BLOCK_MASK) >> BLOCK_SHIFT);
+    }
+
+    template <typename T>
+    void release(std::vector<T>& v)
+    {
+        std::vector<T>().swap(v);
+    }
+
+    void release(BitArray& b)
+    {
+        BitArray().swap(b);
+    }
+}
+
+AdaptiveBitArray::AdaptiveBitArray() : size_bits(0), cardinality(0), sparse(true) {}
+
+AdaptiveBitArray::AdaptiveBitArray(int size_bits, unsigned long value)
+    : size_bits(size_bits), cardinality(0), sparse(true) {
+    if (size_bits < 0) throw std::invalid_argument("Кол-во битов не может быть отрицательным");
+    reset_blocks();
+    for (int i = 0; i < size_bits && i < VALUE_BITS; ++i) {
+        if ((value >> i) & 1) {
+            blocks[0].push_back(static_cast<uint16_t>(i));
+            ++cardinality;
+        }
+    }
+    adapt();
+}
+
+AdaptiveBitArray::AdaptiveBitArray(const BitArray& b)
+    : size_bits(b.size()), cardinality(b.count()), sparse(false), dense(b) {
+    adapt();
+}
+
+void AdaptiveBitArray::swap(AdaptiveBitArray& b) {
+    std::swap(size_bits, b.size_bits);
+    std::swap(cardinality, b.cardinality);
+    std::swap(sparse, b.sparse);
+    blocks.swap(b.blocks);
+    dense.swap(b.dense);
+}
+
+void AdaptiveBitArray::resize(int new_size, bool value) {
+    if (new_size < 0) throw std::invalid_argument("Размер не может быть отрицательным");
+
+    if (sparse && new_size > size_bits && value) make_dense();
+
+    if (sparse) {
+        if (new_size < size_bits && new_size > 0) {
+            Block& last = blocks[(new_size - 1) >> BLOCK_SHIFT];
+            int end = ((new_size - 1) & BLOCK_MASK) + 1;
+            last.erase(std::lower_bound(last.begin(), last.end(), end), last.end());
+        }
+        blocks.resize(block_count(new_size));
+        size_bits = new_size;
+        cardinality = sparse_count();
+    } else {
+        int old_size = size_bits;
+        dense.resize(new_size, value);
+        if (new_size < old_size) {
+            cardinality = dense.count();
+        } else if (value) {
+            cardinality += new_size - old_size;
+        }
+        size_bits = new_size;
+    }
+    adapt();
+}
+
+void AdaptiveBitArray::clear() {
+    size_bits = 0;
+    cardinality = 0;
+    sparse = true;
+    release(blocks);
+    release(dense);
+}
+
+void AdaptiveBitArray::push_back(bool bit) {
+    if (sparse) {
+        blocks.resize(block_count(size_bits + 1));
+        if (bit) blocks.back().push_back(static_cast<uint16_t>(size_bits & BLOCK_MASK));
+    } else {
+        dense.push_back(bit);
+    }
+    ++size_bits;
+    cardinality += bit;
+    adapt();
+}
+
+AdaptiveBitArray& AdaptiveBitArray::operator&=(const AdaptiveBitArray& b) {
+    check_size_compatibility(b);
+    if (sparse && b.sparse) {
+        for (size_t k = 0; k < blocks.size(); ++k) {
+            Block result;
+            std::set_intersection(blocks[k].begin(), blocks[k].end(), b.blocks[k].begin(), b.blocks[k].end(),
+                                  std::back_inserter(result));
+            blocks[k].swap(result);
+        }
+    } else if (sparse) {
+        for (size_t k = 0; k < blocks.size(); ++k) {
+            int base = static_cast<int>(k << BLOCK_SHIFT);
+            blocks[k].erase(std::remove_if(blocks[k].begin(), blocks[k].end(),
+                                           [&b, base](uint16_t low) { return !b.dense[base + low]; }),
+                            blocks[k].end());
+        }
+    } else if (b.sparse) {
+        std::vector<Block> result(b.blocks.size());
+        for (size_t k = 0; k < b.blocks.size(); ++k) {
+            int base = static_cast<int>(k << BLOCK_SHIFT);
+            for (uint16_t low : b.blocks[k]) {
+                if (dense[base + low]) result[k].push_back(low);
+            }
+        }
+        blocks.swap(result);
+        release(dense);
+        sparse = true;
+    } else {
+        dense &= b.dense;
+        cardinality = dense.count();
+    }
+    if (sparse) cardinality = sparse_count();
+    adapt();
+    return *this;
+}
+
+AdaptiveBitArray& AdaptiveBitArray::operator|=(const AdaptiveBitArray& b) {
+    check_size_compatibility(b);
+    if (sparse && b.sparse) {
+        for (size_t k = 0; k < blocks.size(); ++k) {
+            Block result;
+            std::set_union(blocks[k].begin(), blocks[k].end(), b.blocks[k].begin(), b.blocks[k].end(),
+                           std::back_inserter(result));
+            blocks[k].swap(result);
+        }
+        cardinality = sparse_count();
+    } else if (sparse) {
+        BitArray result(b.dense);
+        for (int i : sparse_indices()) result.set(i);
+        dense.swap(result);
+        release(blocks);
+        sparse = false;
+        cardinality = dense.count();
+    } else if (b.sparse) {
+        for (int i : b.sparse_indices()) {
+            if (!dense[i]) {
+                dense.set(i);
+                ++cardinality;
+            }
+        }
+    } else {
+        dense |= b.dense;
+        cardinality = dense.count();
+    }
+    adapt();
+    return *this;
+}
+
+AdaptiveBitArray& AdaptiveBitArray::operator^=(const AdaptiveBitArray& b) {
+    check_size_compatibility(b);
+    if (sparse && b.sparse) {
+        for (size_t k = 0; k < blocks.size(); ++k) {
+            Block result;
+            std::set_symmetric_difference(blocks[k].begin(), blocks[k].end(), b.blocks[k].begin(), b.blocks[k].end(),
+                                          std::back_inserter(result));
+            blocks[k].swap(result);
+        }
+        cardinality = sparse_count();
+    } else if (sparse) {
+        BitArray result(b.dense);
+        for (int i : sparse_indices()) result.set(i, !result[i]);
+        dense.swap(result);
+        release(blocks);
+        sparse = false;
+        cardinality = dense.count();
+    } else if (b.sparse) {
+        for (int i : b.sparse_indices()) {
+            bool bit = dense[i];
+            dense.set(i, !bit);
+            cardinality += bit ? -1 : 1;
+        }
+    } else {
+        dense ^= b.dense;
+        cardinality = dense.count();
+    }
+    adapt();
+    return *this;
+}
+
+AdaptiveBitArray& AdaptiveBitArray::operator<<=(int n) {
+    if (n < 0) throw std::invalid_argument("Количество сдвигов не может быть отрицательным");
+    if (sparse) {
+        std::vector<int> result;
+        for (int i : sparse_indices()) {
+            if (i >= n) result.push_back(i - n);
+        }
+        assign_indices(result);
+    } else {
+        dense <<= n;
+        cardinality = dense.count();
+    }
+    adapt();
+    return *this;
+}
+
+AdaptiveBitArray& AdaptiveBitArray::operator>>=(int n) {
+    if (n < 0) throw std::invalid_argument("Количество сдвигов не может быть отрицательным");
+    if (sparse) {
+        int limit = n >= size_bits ? 0 : size_bits - n;
+        std::vector<int> result;
+        for (int i : sparse_indices()) {
+            if (i >= limit) break;
+            result.push_back(i + n);
+        }
+        assign_indices(result);
+    } else {
+        dense >>= n;
+        cardinality = dense.count();
+    }
+    adapt();
+    return *this;
+}
+
+AdaptiveBitArray AdaptiveBitArray::operator<<(int n) const {
+    AdaptiveBitArray result(*this);
+    result <<= n;
+    return result;
+}
+
+AdaptiveBitArray AdaptiveBitArray::operator>>(int n) const {
+    AdaptiveBitArray result(*this);
+    result >>= n;
+    return result;
+}
+
+AdaptiveBitArray& AdaptiveBitArray::set(int n, bool val) {
+    if (n < 0 || n >= size_bits) throw std::out_of_range("Выход за границу");
+    if (sparse) {
+        Block& block = blocks[n >> BLOCK_SHIFT];
+        uint16_t low = static_cast<uint16_t>(n & BLOCK_MASK);
+        auto it = std::lower_bound(block.begin(), block.end(), low);
+        bool present = it != block.end() && *it == low;
+        if (val && !present) {
+            block.insert(it, low);
+            ++cardinality;
+        } else if (!val && present) {
+            block.erase(it);
+            --cardinality;
+        }
+    } else {
+        bool old = dense[n];
+        dense.set(n, val);
+        cardinality += static_cast<int>(val) - static_cast<int>(old);
+    }
+    adapt();
+    return *this;
+}
+
+AdaptiveBitArray& AdaptiveBitArray::set() {
+    BitArray result(size_bits);
+    result.set();
+    dense.swap(result);
+    release(blocks);
+    sparse = false;
+    cardinality = size_bits;
+    adapt();
+    return *this;
+}
+
+AdaptiveBitArray& AdaptiveBitArray::reset(int n) {
+    return set(n, false);
+}
+
+AdaptiveBitArray& AdaptiveBitArray::reset() {
+    release(dense);
+    reset_blocks();
+    sparse = true;
+    cardinality = 0;
+    return *this;
+}
+
+bool AdaptiveBitArray::any() const {
+    return cardinality > 0;
+}
+
+bool AdaptiveBitArray::none() const {
+    return cardinality == 0;
+}
+
+AdaptiveBitArray AdaptiveBitArray::operator~() const {
+    AdaptiveBitArray result;
+    result.size_bits = size_bits;
+    result.sparse = false;
+    result.cardinality = size_bits - cardinality;
+    if (sparse) {
+        BitArray inverted(size_bits);
+        inverted.set();
+        for (int i : sparse_indices()) inverted.reset(i);
+        result.dense.swap(inverted);
+    } else {
+        result.dense = ~dense;
+    }
+    result.adapt();
+    return result;
+}
+
+int AdaptiveBitArray::count() const {
+    return cardinality;
+}
+
+bool AdaptiveBitArray::operator[](int i) const {
+    if (i < 0 || i >= size_bits) throw std::out_of_range("Выход за границу");
+    if (!sparse) return dense[i];
+    const Block& block = blocks[i >> BLOCK_SHIFT];
+    return std::binary_search(block.begin(), block.end(), static_cast<uint16_t>(i & BLOCK_MASK));
+}
+
+int AdaptiveBitArray::size() const {
+    return size_bits;
+}
+
+bool AdaptiveBitArray::empty() const {
+    return size_bits == 0;
+}
+
+std::string AdaptiveBitArray::to_string() const {
+    if (!sparse) return dense.to_string();
+    std::string result(size_bits, '0');
+    for (int i : sparse_indices()) result[i] = '1';
+    return result;
+}
+
+int AdaptiveBitArray::find_next(int from) const {
+    if (from < 0) throw std::out_of_range("Выход за границу");
+    if (!sparse) return dense.find_next(from);
+    if (from >= size_bits) return -1;
+    size_t k = from >> BLOCK_SHIFT;
+    const Block& first = blocks[k];
+    auto it = std::lower_bound(first.begin(), first.end(), static_cast<uint16_t>(from & BLOCK_MASK));
+    if (it != first.end()) return static_cast<int>(k << BLOCK_SHIFT) + *it;
+    for (++k; k < blocks.size(); ++k) {
+        if (!blocks[k].empty()) return static_cast<int>(k << BLOCK_SHIFT) + blocks[k].front();
+    }
+    return -1;
+}
+
+bool AdaptiveBitArray::is_sparse() const {
+    return sparse;
+}
+
+BitArray AdaptiveBitArray::to_bit_array() const {
+    if (!sparse) return dense;
+    BitArray result(size_bits);
+    for (int i : sparse_indices()) result.set(i);
+    return result;
+}
+
+void AdaptiveBitArray::reset_blocks() {
+    std::vector<Block>(block_count(size_bits)).swap(blocks);
+}
+
+void AdaptiveBitArray::assign_indices(const std::vector<int>& sorted) {
+    reset_blocks();
+    for (int i : sorted) blocks[i >> BLOCK_SHIFT].push_back(static_cast<uint16_t>(i & BLOCK_MASK));
+    cardinality = static_cast<int>(sorted.size());
+}
+
+std::vector<int> AdaptiveBitArray::sparse_indices() const {
+    std::vector<int> result;
+    result.reserve(cardinality);
+    for (size_t k = 0; k < blocks.size(); ++k) {
+        int base = static_cast<int>(k << BLOCK_SHIFT);
+        for (uint16_t low : blocks[k]) result.push_back(base + low);
+    }
+    return result;
+}
+
+int AdaptiveBitArray::sparse_count() const {
+    size_t count = 0;
+    for (const Block& block : blocks) count += block.size();
+    return static_cast<int>(count);
+}
+
+void AdaptiveBitArray::make_sparse() {
+    reset_blocks();
+    for (int i = dense.find_next(0); i != -1; i = dense.find_next(i + 1)) {
+        blocks[i >> BLOCK_SHIFT].push_back(static_cast<uint16_t>(i & BLOCK_MASK));
+    }
+    release(dense);
+    sparse = true;
+}
+
+void AdaptiveBitArray::make_dense() {
+    BitArray result(size_bits);
+    for (int i : sparse_indices()) result.set(i);
+    dense.swap(result);
+    release(blocks);
+    sparse = false;
+}
+
+void AdaptiveBitArray::adapt() {
+    if (sparse && cardinality > size_bits / DENSE_DIVISOR) {
+        make_dense();
+    } else if (!sparse && cardinality < size_bits / SPARSE_DIVISOR) {
+        make_sparse();
+    }
+}
+
+void AdaptiveBitArray::check_size_compatibility(const AdaptiveBitArray& b) const {
+    if (size_bits != b.size_bits) {
+        throw std::invalid_argument("Массивы должны иметь одинаковый размер");
+    }
+}
+
+bool operator==(const AdaptiveBitArray& a, const AdaptiveBitArray& b) {
+    if (a.size() != b.size() || a.count() != b.count()) return false;
+    for (int i = a.find_next(0); i != -1; i = a.find_next(i + 1)) {
+        if (!b[i]) return false;
+    }
+    return true;
+}
+
+bool operator!=(const AdaptiveBitArray& a, const AdaptiveBitArray& b) {
+    return !(a == b);
+}
+
+AdaptiveBitArray operator&(const AdaptiveBitArray& b1, const AdaptiveBitArray& b2) {
+    AdaptiveBitArray result(b1);
+    result &= b2;
+    return result;
+}
+
+AdaptiveBitArray operator|(const AdaptiveBitArray& b1, const AdaptiveBitArray& b2) {
+    AdaptiveBitArray result(b1);
+    result |= b2;
+    return result;
+}
+
+AdaptiveBitArray operator^(const AdaptiveBitArray& b1, const AdaptiveBitArray& b2) {
+    AdaptiveBitArray result(b1);
+    result ^= b2;
+    return result;
+}
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "bit_arr.hpp"
+
+// Битовый массив с тем же интерфейсом, что и BitArray, который сам выбирает
+// представление: для разреженных данных - отсортированные списки младших 16 бит
+// индексов единиц, по одному на каждый блок из 2^16 бит, или плотный BitArray.
+// Переключение происходит по числу единиц с гистерезисом, чтобы массив
+// не метался между режимами на границе.
+class AdaptiveBitArray {
+public:
+    AdaptiveBitArray();
+
+    explicit AdaptiveBitArray(int size_bits, unsigned long value = 0);
+    explicit AdaptiveBitArray(const BitArray& b);
+
+    void swap(AdaptiveBitArray& b);
+
+    void resize(int new_size, bool value = false);
+    void clear();
+    void push_back(bool bit);
+
+    AdaptiveBitArray& operator&=(const AdaptiveBitArray& b);
+    AdaptiveBitArray& operator|=(const AdaptiveBitArray& b);
+    AdaptiveBitArray& operator^=(const AdaptiveBitArray& b);
+
+    AdaptiveBitArray& operator<<=(int n);
+    AdaptiveBitArray& operator>>=(int n);
+    AdaptiveBitArray operator<<(int n) const;
+    AdaptiveBitArray operator>>(int n) const;
+
+    AdaptiveBitArray& set(int n, bool val = true);
+    AdaptiveBitArray& set();
+    AdaptiveBitArray& reset(int n);
+    AdaptiveBitArray& reset();
+
+    bool any() const;
+    bool none() const;
+    AdaptiveBitArray operator~() const;
+    int count() const;
+
+    bool operator[](int i) const;
+    int size() const;
+    bool empty() const;
+
+    std::string to_string() const;
+
+    //Индекс первого единичного бита, начиная с from, или -1.
+    int find_next(int from) const;
+    bool is_sparse() const;
+    BitArray to_bit_array() const;
+
+private:
+    int size_bits;
+    int cardinality;
+    bool sparse;
+    std::vector<std::vector<uint16_t>> blocks;
+    BitArray dense;
+
+    void reset_blocks();
+    void assign_indices(const std::vector<int>& sorted);
+    std::vector<int> sparse_indices() const;
+    int sparse_count() const;
+    void make_sparse();
+    void make_dense();
+    void adapt();
+    void check_size_compatibility(const AdaptiveBitArray& b) const;
+};
+
+bool operator==(const AdaptiveBitArray& a, const AdaptiveBitArray& b);
+bool operator!=(const AdaptiveBitArray& a, const AdaptiveBitArray& b);
+
+AdaptiveBitArray operator&(const AdaptiveBitArray& b1, const AdaptiveBitArray& b2);
+AdaptiveBitArray operator|(const AdaptiveBitArray& b1, const AdaptiveBitArray& b2);
+AdaptiveBitArray operator^(const AdaptiveBitArray& b1, const AdaptiveBitArray& b2);
@@ -0,0 +1,111 @@
+#include "adaptive_bit_arr.hpp"
+#include <gtest/gtest.h>
+
+
+namespace
+{
+    AdaptiveBitArray every_nth(int size, int step, int offset = 0) {
+        AdaptiveBitArray a(size);
+        for (int i = offset; i < size; i += step) a.set(i);
+        return a;
+    }
+}
+
+TEST(AdaptiveBitArrayTest, StartsSparse) {
+    AdaptiveBitArray a(100000);
+    EXPECT_TRUE(a.is_sparse());
+    EXPECT_TRUE(a.none());
+    a.set(12345);
+    EXPECT_TRUE(a.is_sparse());
+    EXPECT_TRUE(a[12345]);
+    EXPECT_EQ(a.count(), 1);
+}
+
+TEST(AdaptiveBitArrayTest, SwitchesRepresentation) {
+    AdaptiveBitArray a = every_nth(6400, 10);
+    EXPECT_FALSE(a.is_sparse());
+    EXPECT_EQ(a.count(), 640);
+
+    for (int i = 0; i < 6400; i += 20) a.reset(i);
+    EXPECT_FALSE(a.is_sparse());
+    for (int i = 10; i < 6400; i += 20) a.reset(i);
+    EXPECT_TRUE(a.is_sparse());
+    EXPECT_EQ(a.count(), 0);
+}
+
+TEST(AdaptiveBitArrayTest, MixedOperationsMatchBitArray) {
+    AdaptiveBitArray sparse = every_nth(4096, 97, 3);
+    AdaptiveBitArray dense = every_nth(4096, 3, 1);
+    ASSERT_TRUE(sparse.is_sparse());
+    ASSERT_FALSE(dense.is_sparse());
+
+    BitArray s = sparse.to_bit_array();
+    BitArray d = dense.to_bit_array();
+
+    EXPECT_EQ((sparse & dense).to_bit_array(), s & d);
+    EXPECT_EQ((dense & sparse).to_bit_array(), d & s);
+    EXPECT_EQ((sparse | dense).to_bit_array(), s | d);
+    EXPECT_EQ((dense | sparse).to_bit_array(), d | s);
+    EXPECT_EQ((sparse ^ dense).to_bit_array(), s ^ d);
+    EXPECT_EQ((dense ^ sparse).to_bit_array(), d ^ s);
+    EXPECT_EQ((sparse ^ sparse).count(), 0);
+    EXPECT_EQ((~sparse).to_bit_array(), ~s);
+    EXPECT_EQ((sparse & dense).count(), (s & d).count());
+}
+
+TEST(AdaptiveBitArrayTest, SparseAcrossBlocks) {
+    const int size = 5 * 65536 + 123;
+    AdaptiveBitArray a = every_nth(size, 4099, 7);
+    AdaptiveBitArray b = every_nth(size, 3001, 65535);
+    ASSERT_TRUE(a.is_sparse());
+    ASSERT_TRUE(b.is_sparse());
+    BitArray x = a.to_bit_array();
+    BitArray y = b.to_bit_array();
+
+    EXPECT_EQ((a & b).to_bit_array(), x & y);
+    EXPECT_EQ((a | b).to_bit_array(), x | y);
+    EXPECT_EQ((a ^ b).to_bit_array(), x ^ y);
+    EXPECT_EQ((a << 70000).to_bit_array(), x << 70000);
+    EXPECT_EQ((b >> 65537).to_bit_array(), y >> 65537);
+    EXPECT_EQ(b.find_next(65536), 65535 + 3001);
+    EXPECT_EQ(a.find_next(size - 100), -1);
+
+    b.resize(2 * 65536 + 10);
+    y.resize(2 * 65536 + 10);
+    EXPECT_EQ(b.to_bit_array(), y);
+    EXPECT_EQ(b.count(), y.count());
+    b.push_back(true);
+    EXPECT_TRUE(b[2 * 65536 + 10]);
+}
+
+TEST(AdaptiveBitArrayTest, ShiftsMatchBitArray) {
+    AdaptiveBitArray a = every_nth(1000, 101, 5);
+    BitArray b = a.to_bit_array();
+    EXPECT_EQ((a << 7).to_bit_array(), b << 7);
+    EXPECT_EQ((a >> 7).to_bit_array(), b >> 7);
+    EXPECT_EQ((a >> 2000).count(), 0);
+}
+
+TEST(AdaptiveBitArrayTest, PushBackResizeAndFindNext) {
+    AdaptiveBitArray a;
+    for (int i = 0; i < 300; ++i) a.push_back(i % 100 == 0);
+    EXPECT_EQ(a.size(), 300);
+    EXPECT_EQ(a.count(), 3);
+    EXPECT_EQ(a.find_next(1), 100);
+    EXPECT_EQ(a.find_next(201), -1);
+
+    a.resize(150);
+    EXPECT_EQ(a.count(), 2);
+    a.resize(200, true);
+    EXPECT_EQ(a.count(), 52);
+    EXPECT_TRUE(a[199]);
+    EXPECT_EQ(a.to_string().substr(98, 4), "0010");
+}
+
+TEST(AdaptiveBitArrayTest, Errors) {
+    AdaptiveBitArray a(8), b(16);
+    EXPECT_THROW(a &= b, std::invalid_argument);
+    EXPECT_THROW(a[8], std::out_of_range);
+    EXPECT_THROW(a.set(-1), std::out_of_range);
+    EXPECT_THROW(AdaptiveBitArray(-1), std::invalid_argument);
+}
@@ -0,0 +1,385 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+// Политики хранения блоков для BasicBitArray. Каждая политика хранит массив
+// блоков, reserve(n) гарантирует не меньше n блоков, новые блоки нулевые.
+
+// Блоки в куче через calloc с геометрическим ростом, как у BitArray.
+template <typename Block>
+class HeapStorage {
+public:
+    typedef Block block_type;
+
+    HeapStorage() : blocks(nullptr), capacity_blocks(0) {}
+    ~HeapStorage() { free(blocks); }
+
+    HeapStorage(const HeapStorage& s) : blocks(nullptr), capacity_blocks(0) {
+        reserve(s.capacity_blocks);
+        if (s.capacity_blocks > 0) memcpy(blocks, s.blocks, s.capacity_blocks * sizeof(Block));
+    }
+
+    HeapStorage& operator=(const HeapStorage& s) {
+        HeapStorage temp(s);
+        swap(temp);
+        return *this;
+    }
+
+    void swap(HeapStorage& s) {
+        std::swap(blocks, s.blocks);
+        std::swap(capacity_blocks, s.capacity_blocks);
+    }
+
+    Block* data() { return blocks; }
+    const Block* data() const { return blocks; }
+    int capacity() const { return capacity_blocks; }
+
+    void reserve(int n) {
+        if (n <= capacity_blocks) return;
+        int new_capacity = std::max(n, capacity_blocks * 2);
+        Block* new_blocks = static_cast<Block*>(calloc(new_capacity, sizeof(Block)));
+        if (!new_blocks) throw std::bad_alloc();
+        if (blocks) {
+            memcpy(new_blocks, blocks, capacity_blocks * sizeof(Block));
+            free(blocks);
+        }
+        blocks = new_blocks;
+        capacity_blocks = new_capacity;
+    }
+
+private:
+    Block* blocks;
+    int capacity_blocks;
+};
+
+// N блоков внутри объекта, без обращений к куче. Больше N блоков не помещается.
+template <typename Block, int N>
+class InlineStorage {
+public:
+    typedef Block block_type;
+
+    InlineStorage() : blocks() {}
+
+    void swap(InlineStorage& s) { std::swap_ranges(blocks, blocks + N, s.blocks); }
+
+    Block* data() { return blocks; }
+    const Block* data() const { return blocks; }
+    int capacity() const { return N; }
+
+    void reserve(int n) {
+        if (n > N) throw std::length_error("Превышена ёмкость встроенного хранилища");
+    }
+
+private:
+    Block blocks[N];
+};
+
+// Блоки в std::vector.
+template <typename Block>
+class VectorStorage {
+public:
+    typedef Block block_type;
+
+    void swap(VectorStorage& s) { blocks.swap(s.blocks); }
+
+    Block* data() { return blocks.data(); }
+    const Block* data() const { return blocks.data(); }
+    int capacity() const { return static_cast<int>(blocks.size()); }
+
+    void reserve(int n) {
+        if (n <= capacity()) return;
+        blocks.resize(std::max(n, capacity() * 2), 0);
+    }
+
+private:
+    std::vector<Block> blocks;
+};
+
+// Операции над массивом блоков, общие для BasicBitArray и BitArray (у него это
+// блоки uint8_t поверх байтового буфера). Бит i лежит в блоке i / BLOCK_BITS на
+// позиции i % BLOCK_BITS; nb - число занятых блоков.
+namespace bit_blocks
+{
+    template <typename Block>
+    void fill_range(Block* b, int from, int to, bool val)
+    {
+        if (from >= to) return;
+        const int BLOCK_BITS = static_cast<int>(sizeof(Block) * 8);
+        const Block ones = static_cast<Block>(~Block(0));
+        int first = from / BLOCK_BITS;
+        int last = (to - 1) / BLOCK_BITS;
+        Block head = static_cast<Block>(ones << (from % BLOCK_BITS));
+        Block tail = static_cast<Block>(ones >> (BLOCK_BITS - 1 - (to - 1) % BLOCK_BITS));
+        if (first == last) head &= tail;
+        b[first] = val ? static_cast<Block>(b[first] | head) : static_cast<Block>(b[first] & ~head);
+        if (first == last) return;
+        std::fill(b + first + 1, b + last, val ? ones : Block(0));
+        b[last] = val ? static_cast<Block>(b[last] | tail) : static_cast<Block>(b[last] & ~tail);
+    }
+
+    //Бит i получает бит i + n, старшие биты заполняются нулями.
+    template <typename Block>
+    void shift_down(Block* b, int nb, int n)
+    {
+        const int BLOCK_BITS = static_cast<int>(sizeof(Block) * 8);
+        int block_shift = n / BLOCK_BITS;
+        int bit_shift = n % BLOCK_BITS;
+        for (int k = 0; k < nb; ++k) {
+            int src = k + block_shift;
+            Block lo = src < nb ? static_cast<Block>(b[src] >> bit_shift) : 0;
+            Block hi = bit_shift && src + 1 < nb ? static_cast<Block>(b[src + 1] << (BLOCK_BITS - bit_shift)) : 0;
+            b[k] = lo | hi;
+        }
+    }
+
+    //Бит i получает бит i - n. Биты, попавшие за конец массива внутри последнего блока, не очищаются.
+    template <typename Block>
+    void shift_up(Block* b, int nb, int n)
+    {
+        const int BLOCK_BITS = static_cast<int>(sizeof(Block) * 8);
+        int block_shift = n / BLOCK_BITS;
+        int bit_shift = n % BLOCK_BITS;
+        for (int k = nb - 1; k >= 0; --k) {
+            int src = k - block_shift;
+            Block lo = src >= 0 ? static_cast<Block>(b[src] << bit_shift) : 0;
+            Block hi = bit_shift && src - 1 >= 0 ? static_cast<Block>(b[src - 1] >> (BLOCK_BITS - bit_shift)) : 0;
+            b[k] = lo | hi;
+        }
+    }
+
+    //dst[k] = op(dst[k], src[k]) для всех блоков.
+    template <typename Block, typename Op>
+    void combine(Block* dst, const Block* src, int nb, Op op)
+    {
+        for (int k = 0; k < nb; ++k) dst[k] = static_cast<Block>(op(dst[k], src[k]));
+    }
+
+    //Инвертирует блоки; лишние биты последнего блока вызывающий очищает сам.
+    template <typename Block>
+    void invert(Block* b, int nb)
+    {
+        for (int k = 0; k < nb; ++k) b[k] = static_cast<Block>(~b[k]);
+    }
+
+    template <typename Block>
+    bool any(const Block* b, int nb)
+    {
+        for (int k = 0; k < nb; ++k) {
+            if (b[k]) return true;
+        }
+        return false;
+    }
+}
+
+
+// Битовый массив с тем же интерфейсом, что и BitArray, параметризованный
+// типом блока (uint8_t, uint32_t, uint64_t) и политикой хранения.
+// Бит i лежит в блоке i / BLOCK_BITS на позиции i % BLOCK_BITS; биты за
+// пределами size() всегда нулевые.
+template <typename Block, typename Storage = HeapStorage<Block>>
+class BasicBitArray {
+    static_assert(std::is_unsigned<Block>::value, "Блок должен быть беззнаковым целым");
+    static_assert(std::is_same<typename Storage::block_type, Block>::value,
+                  "Политика хранения должна хранить блоки того же типа");
+
+public:
+    static const int BLOCK_BITS = static_cast<int>(sizeof(Block) * 8);
+
+    BasicBitArray() : size_bits(0) {}
+
+    explicit BasicBitArray(int size_bits, unsigned long value = 0) : size_bits(0) {
+        if (size_bits < 0) throw std::invalid_argument("Кол-во битов не может быть отрицательным");
+        resize(size_bits);
+        for (int i = 0; i < size_bits && i < static_cast<int>(sizeof(unsigned long) * 8); ++i) {
+            if ((value >> i) & 1) set(i);
+        }
+    }
+
+    void swap(BasicBitArray& b) {
+        storage.swap(b.storage);
+        std::swap(size_bits, b.size_bits);
+    }
+
+    void resize(int new_size, bool value = false) {
+        if (new_size < 0) throw std::invalid_argument("Размер не может быть отрицательным");
+        if (new_size <= size_bits) {
+            bit_blocks::fill_range(blocks(), new_size, size_bits, false);
+        } else {
+            storage.reserve(blocks_for(new_size));
+            if (value) bit_blocks::fill_range(blocks(), size_bits, new_size, true);
+        }
+        size_bits = new_size;
+    }
+
+    void clear() { resize(0); }
+
+    void push_back(bool bit) {
+        if (size_bits == storage.capacity() * BLOCK_BITS) storage.reserve(blocks_for(size_bits + 1));
+        int n = size_bits++;
+        if (bit) set(n);
+    }
+
+    BasicBitArray& operator&=(const BasicBitArray& b) {
+        check_size_compatibility(b);
+        bit_blocks::combine(blocks(), b.blocks(), used_blocks(), std::bit_and<Block>());
+        return *this;
+    }
+
+    BasicBitArray& operator|=(const BasicBitArray& b) {
+        check_size_compatibility(b);
+        bit_blocks::combine(blocks(), b.blocks(), used_blocks(), std::bit_or<Block>());
+        return *this;
+    }
+
+    BasicBitArray& operator^=(const BasicBitArray& b) {
+        check_size_compatibility(b);
+        bit_blocks::combine(blocks(), b.blocks(), used_blocks(), std::bit_xor<Block>());
+        return *this;
+    }
+
+    //Как и у BitArray, бит i после сдвига берётся из бита i + n.
+    BasicBitArray& operator<<=(int n) {
+        if (n < 0) throw std::invalid_argument("Количество сдвигов не может быть отрицательным");
+        bit_blocks::shift_down(blocks(), used_blocks(), n);
+        return *this;
+    }
+
+    BasicBitArray& operator>>=(int n) {
+        if (n < 0) throw std::invalid_argument("Количество сдвигов не может быть отрицательным");
+        bit_blocks::shift_up(blocks(), used_blocks(), n);
+        bit_blocks::fill_range(blocks(), size_bits, used_blocks() * BLOCK_BITS, false);
+        return *this;
+    }
+
+    BasicBitArray operator<<(int n) const {
+        BasicBitArray result(*this);
+        result <<= n;
+        return result;
+    }
+
+    BasicBitArray operator>>(int n) const {
+        BasicBitArray result(*this);
+        result >>= n;
+        return result;
+    }
+
+    BasicBitArray& set(int n, bool val = true) {
+        check_index(n);
+        Block mask = static_cast<Block>(Block(1) << (n % BLOCK_BITS));
+        if (val) {
+            blocks()[n / BLOCK_BITS] |= mask;
+        } else {
+            blocks()[n / BLOCK_BITS] &= static_cast<Block>(~mask);
+        }
+        return *this;
+    }
+
+    BasicBitArray& set() {
+        bit_blocks::fill_range(blocks(), 0, size_bits, true);
+        return *this;
+    }
+
+    BasicBitArray& reset(int n) { return set(n, false); }
+
+    BasicBitArray& reset() {
+        bit_blocks::fill_range(blocks(), 0, size_bits, false);
+        return *this;
+    }
+
+    bool any() const { return bit_blocks::any(blocks(), used_blocks()); }
+
+    bool none() const { return !any(); }
+
+    BasicBitArray operator~() const {
+        BasicBitArray result(*this);
+        bit_blocks::invert(result.blocks(), used_blocks());
+        bit_blocks::fill_range(result.blocks(), size_bits, used_blocks() * BLOCK_BITS, false);
+        return result;
+    }
+
+    int count() const {
+        int result = 0;
+        for (int i = 0; i < used_blocks(); ++i) result += __builtin_popcountll(blocks()[i]);
+        return result;
+    }
+
+    bool operator[](int i) const {
+        check_index(i);
+        return (blocks()[i / BLOCK_BITS] >> (i % BLOCK_BITS)) & 1;
+    }
+
+    int size() const { return size_bits; }
+    bool empty() const { return size_bits == 0; }
+
+    std::string to_string() const {
+        std::string result(size_bits, '0');
+        for (int i = 0; i < size_bits; ++i) result[i] = '0' + operator[](i);
+        return result;
+    }
+
+    friend bool operator==(const BasicBitArray& a, const BasicBitArray& b) {
+        if (a.size_bits != b.size_bits) return false;
+        return std::equal(a.blocks(), a.blocks() + a.used_blocks(), b.blocks());
+    }
+
+private:
+    Storage storage;
+    int size_bits;
+
+    static int blocks_for(int bits) { return (bits + BLOCK_BITS - 1) / BLOCK_BITS; }
+    int used_blocks() const { return blocks_for(size_bits); }
+    Block* blocks() { return storage.data(); }
+    const Block* blocks() const { return storage.data(); }
+
+    void check_index(int i) const {
+        if (i < 0 || i >= size_bits) throw std::out_of_range("Выход за границу");
+    }
+
+    void check_size_compatibility(const BasicBitArray& b) const {
+        if (size_bits != b.size_bits) throw std::invalid_argument("Массивы должны иметь одинаковый размер");
+    }
+};
+
+template <typename Block, typename Storage>
+bool operator!=(const BasicBitArray<Block, Storage>& a, const BasicBitArray<Block, Storage>& b) {
+    return !(a == b);
+}
+
+template <typename Block, typename Storage>
+BasicBitArray<Block, Storage> operator&(const BasicBitArray<Block, Storage>& b1, const BasicBitArray<Block, Storage>& b2) {
+    BasicBitArray<Block, Storage> result(b1);
+    result &= b2;
+    return result;
+}
+
+template <typename Block, typename Storage>
+BasicBitArray<Block, Storage> operator|(const BasicBitArray<Block, Storage>& b1, const BasicBitArray<Block, Storage>& b2) {
+    BasicBitArray<Block, Storage> result(b1);
+    result |= b2;
+    return result;
+}
+
+template <typename Block, typename Storage>
+BasicBitArray<Block, Storage> operator^(const BasicBitArray<Block, Storage>& b1, const BasicBitArray<Block, Storage>& b2) {
+    BasicBitArray<Block, Storage> result(b1);
+    result ^= b2;
+    return result;
+}
+
+// Готовые раскладки. PackedBitArray8 совпадает по раскладке с BitArray,
+// VectorBitArray хранит слова по 64 бита в std::vector.
+typedef BasicBitArray<uint8_t, HeapStorage<uint8_t>> PackedBitArray8;
+typedef BasicBitArray<uint32_t, HeapStorage<uint32_t>> PackedBitArray32;
+typedef BasicBitArray<uint64_t, HeapStorage<uint64_t>> PackedBitArray64;
+typedef BasicBitArray<uint64_t, VectorStorage<uint64_t>> VectorBitArray;
+template <int Bits>
+using InlineBitArray = BasicBitArray<uint64_t, InlineStorage<uint64_t, (Bits + 63) / 64>>;
@@ -0,0 +1,82 @@
+#include "basic_bit_array.hpp"
+#include "bit_arr.hpp"
+#include <gtest/gtest.h>
+
+
+template <typename T>
+class BasicBitArrayTest : public testing::Test {};
+
+typedef testing::Types<PackedBitArray8, PackedBitArray32, PackedBitArray64, VectorBitArray, InlineBitArray<512>>
+    Layouts;
+TYPED_TEST_SUITE(BasicBitArrayTest, Layouts);
+
+namespace
+{
+    template <typename T>
+    T pattern(int size, int step) {
+        T result(size);
+        for (int i = 0; i < size; i += step) result.set(i);
+        return result;
+    }
+}
+
+TYPED_TEST(BasicBitArrayTest, ConstructorAndToString) {
+    TypeParam b(8, 0b10101010);
+    EXPECT_EQ(b.size(), 8);
+    EXPECT_EQ(b.to_string(), "01010101");
+    EXPECT_EQ(b.count(), 4);
+    EXPECT_THROW(TypeParam(-1), std::invalid_argument);
+}
+
+TYPED_TEST(BasicBitArrayTest, MatchesBitArray) {
+    TypeParam a = pattern<TypeParam>(300, 3);
+    TypeParam b = pattern<TypeParam>(300, 7);
+    BitArray ra = pattern<BitArray>(300, 3);
+    BitArray rb = pattern<BitArray>(300, 7);
+
+    EXPECT_EQ((a & b).to_string(), (ra & rb).to_string());
+    EXPECT_EQ((a | b).to_string(), (ra | rb).to_string());
+    EXPECT_EQ((a ^ b).to_string(), (ra ^ rb).to_string());
+    EXPECT_EQ((~a).to_string(), (~ra).to_string());
+    EXPECT_EQ((~a).count(), (~ra).count());
+    for (int n : {0, 1, 7, 8, 31, 64, 65, 299, 300, 1000}) {
+        EXPECT_EQ((a << n).to_string(), (ra << n).to_string()) << n;
+        EXPECT_EQ((a >> n).to_string(), (ra >> n).to_string()) << n;
+    }
+}
+
+TYPED_TEST(BasicBitArrayTest, ResizeAndPushBack) {
+    TypeParam b;
+    for (int i = 0; i < 100; ++i) b.push_back(i % 4 == 0);
+    EXPECT_EQ(b.size(), 100);
+    EXPECT_EQ(b.count(), 25);
+    b.resize(10);
+    b.resize(200, true);
+    EXPECT_EQ(b.count(), 3 + 190);
+    b.resize(40);
+    b.resize(60);
+    EXPECT_EQ(b.count(), 3 + 30);
+    b.clear();
+    EXPECT_TRUE(b.empty());
+}
+
+TYPED_TEST(BasicBitArrayTest, SetResetAndCompare) {
+    TypeParam a(70);
+    a.set();
+    EXPECT_EQ(a.count(), 70);
+    a.reset(69);
+    EXPECT_FALSE(a[69]);
+    TypeParam b(70);
+    b.set().reset(69);
+    EXPECT_TRUE(a == b);
+    b.reset();
+    EXPECT_TRUE(b.none());
+    EXPECT_TRUE(a != b);
+    EXPECT_THROW(a[70], std::out_of_range);
+    EXPECT_THROW(a &= TypeParam(71), std::invalid_argument);
+}
+
+TEST(BasicBitArrayInlineTest, CapacityIsFixed) {
+    InlineBitArray<64> b(64);
+    EXPECT_THROW(b.push_back(true), std::length_error);
+}
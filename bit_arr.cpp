@@ -1,12 +1,28 @@
 #include "bit_arr.hpp"
+#include "basic_bit_array.hpp"
+#include "bit_array_view.hpp"
+#include "bit_summary.hpp"
+#include "bit_words.hpp"
+#include <cstdlib>
 #include <cstring>
+#include <climits>
 #include <algorithm>
+#include <new>
 #include <sstream>
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/mman.h>
+#define BIT_ARRAY_USE_MMAP 1
+#endif
 
 namespace
 {
     const int BITS_PER_BYTE =  8;
     const int CAPACITY_MULTIPLIER =  2;
+    const int PREFETCH_DISTANCE = 16;
+    // Поиск образца проверяет первые шаги сразу для пачки слов, остальные - только
+    // для слов, где кандидаты ещё остались.
+    const int PATTERN_BATCH_WORDS = 64;
+    const int PATTERN_PREFIX_STEPS = 10;
 }
 
 namespace 
@@ -26,15 +42,94 @@ namespace
         return (size_bits + BITS_PER_BYTE - 1) / BITS_PER_BYTE;
     }
 
+    // Байты BitArray как блоки uint8_t для общих операций из bit_blocks.
+    inline uint8_t* blocks(char* value)
+    {
+        return reinterpret_cast<uint8_t*>(value);
+    }
+
+    inline const uint8_t* blocks(const char* value)
+    {
+        return reinterpret_cast<const uint8_t*>(value);
+    }
+
+    // Блоки от этого размера берутся напрямую через mmap: страницы нулевые и
+    // выделяются системой при первой записи, а рост через mremap ничего не копирует.
+    const size_t MMAP_MIN_BYTES = size_t(1) << 20;
+
+    char* allocate_zeroed(size_t bytes)
+    {
+#ifdef BIT_ARRAY_USE_MMAP
+        if (bytes >= MMAP_MIN_BYTES) {
+            void* p = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            if (p == MAP_FAILED) throw std::bad_alloc();
+            return static_cast<char*>(p);
+        }
+#endif
+        char* p = static_cast<char*>(calloc(bytes > 0 ? bytes : 1, 1));
+        if (!p) throw std::bad_alloc();
+        return p;
+    }
+
+    void release_zeroed(char* p, size_t bytes)
+    {
+#ifdef BIT_ARRAY_USE_MMAP
+        if (p && bytes >= MMAP_MIN_BYTES) {
+            munmap(p, bytes);
+            return;
+        }
+#endif
+        free(p);
+    }
+
+    // Копирует bytes байт в обнулённый блок, пропуская нулевые страницы источника,
+    // чтобы копия большого почти пустого массива не выделяла лишних страниц.
+    void copy_to_zeroed(char* dst, const char* src, size_t bytes)
+    {
+        const size_t PAGE_BYTES = 4096;
+        if (bytes < MMAP_MIN_BYTES) {
+            memcpy(dst, src, bytes);
+            return;
+        }
+        for (size_t pos = 0; pos < bytes; pos += PAGE_BYTES) {
+            size_t len = std::min(PAGE_BYTES, bytes - pos);
+            uint64_t any = 0;
+            size_t i = 0;
+            for (; i + bit_words::WORD_BYTES <= len; i += bit_words::WORD_BYTES) {
+                any |= bit_words::load_u64(src + pos + i);
+            }
+            for (; i < len; ++i) any |= static_cast<unsigned char>(src[pos + i]);
+            if (any) memcpy(dst + pos, src + pos, len);
+        }
+    }
+
+    // Переносит первые used байт блока p размера old_bytes в нулевой блок размера new_bytes.
+    char* grow_zeroed(char* p, size_t old_bytes, size_t used, size_t new_bytes)
+    {
+#if defined(BIT_ARRAY_USE_MMAP) && defined(__linux__)
+        if (p && old_bytes >= MMAP_MIN_BYTES) {
+            void* q = mremap(p, old_bytes, new_bytes, MREMAP_MAYMOVE);
+            if (q == MAP_FAILED) throw std::bad_alloc();
+            return static_cast<char*>(q);
+        }
+#endif
+        char* q = allocate_zeroed(new_bytes);
+        if (p) {
+            copy_to_zeroed(q, p, used);
+            release_zeroed(p, old_bytes);
+        }
+        return q;
+    }
+
 }
 
-BitArray::BitArray() : value(nullptr), size_bits(0), capacity(0) {}
+BitArray::BitArray() : value(nullptr), size_bits(0), capacity(0), tracking(false) {}
 
 BitArray::~BitArray() {
-    delete[] value;
+    release_zeroed(value, capacity);
 }
 
-BitArray::BitArray(int size_bits, unsigned long value) {
+BitArray::BitArray(int size_bits, unsigned long value) : tracking(false) {
     if (size_bits < 0) throw std::invalid_argument("Кол-во битов не может быть отрицательным");
     allocate_memory(size_bits);
     for (int i = 0; i < size_bits && i < static_cast<int>(sizeof(unsigned long) * BITS_PER_BYTE); ++i) {
@@ -42,11 +137,10 @@ BitArray::BitArray(int size_bits, unsigned long value) {
     }
 }
 
-BitArray::BitArray(const BitArray& b) : size_bits(b.size_bits), capacity(b.capacity) {
-    delete[] value;  
+BitArray::BitArray(const BitArray& b) : size_bits(b.size_bits), capacity(b.capacity), tracking(false) {
     if (capacity > 0) {
-        value = new char[capacity];
-        memcpy(value, b.value, capacity);
+        value = allocate_zeroed(capacity);
+        copy_to_zeroed(value, b.value, current_bytes(size_bits));
     } else {
         value = nullptr;
     }
@@ -56,12 +150,23 @@ void BitArray::swap(BitArray& b) {
     std::swap(value, b.value);
     std::swap(size_bits, b.size_bits);
     std::swap(capacity, b.capacity);
+    std::swap(tracking, b.tracking);
+    dirty_mask.swap(b.dirty_mask);
+    dirty_list.swap(b.dirty_list);
+    summary.swap(b.summary);
 }
 
 BitArray& BitArray::operator=(const BitArray& b) {
     if (this != &b) {
+        bool was_tracking = tracking;
+        bool had_summary = summary != nullptr;
         BitArray temp(b);
         swap(temp);
+        if (had_summary) build_summary();
+        if (was_tracking) {
+            track_changes();
+            note_all_changed();
+        }
     }
     return *this;
 }
@@ -75,34 +180,22 @@ void BitArray::resize(int new_size, bool val) {
     
     
     if (new_size <= size_bits) {
+        int old_size = size_bits;
+        bit_blocks::fill_range(blocks(value), new_size, old_size, false);
         size_bits = new_size;
+        if (new_size < old_size) note_change(new_size, old_size - 1);
         return;
     }
     
-    
-    if (new_bytes_needed(new_size) > capacity) {
-        char* new_value = new char[new_bytes_needed(new_size)](); 
-        
-        if (value) {
-            memcpy(new_value, value, current_bytes(size_bits));
-            delete[] value;
-        }
-        
-        value = new_value;
-        capacity = new_bytes_needed(new_size);
-    }
-    
-    for (int i = size_bits; i < new_size; ++i) 
-    {
-        set(i, val);
-    }
-
+    reserve_bytes(new_bytes_needed(new_size));
+    if (val) bit_blocks::fill_range(blocks(value), size_bits, new_size, true);
+    int old_size = size_bits;
     size_bits = new_size;
-        
+    note_change(old_size, new_size - 1);
 }
 
 void BitArray::clear() {
-    size_bits = 0;
+    resize(0);
 }
 
 void BitArray::push_back(bool bit) {
@@ -111,57 +204,37 @@ void BitArray::push_back(bool bit) {
 
 BitArray& BitArray::operator&=(const BitArray& b) {
     check_size_compatibility(b);
-    for (int i = 0; i < (size_bits + 7) / BITS_PER_BYTE; ++i) {
-        value[i] &= b.value[i];
-    }
+    bit_blocks::combine(blocks(value), blocks(b.value), current_bytes(size_bits), std::bit_and<uint8_t>());
+    note_all_changed();
     return *this;
 }
 
 BitArray& BitArray::operator|=(const BitArray& b) {
     check_size_compatibility(b);
-    for (int i = 0; i < (size_bits + 7) / BITS_PER_BYTE; ++i) {
-        value[i] |= b.value[i];
-    }
+    bit_blocks::combine(blocks(value), blocks(b.value), current_bytes(size_bits), std::bit_or<uint8_t>());
+    note_all_changed();
     return *this;
 }
 
 BitArray& BitArray::operator^=(const BitArray& b) {
     check_size_compatibility(b);
-    for (int i = 0; i < (size_bits + 7) / BITS_PER_BYTE; ++i) {
-        value[i] ^= b.value[i];
-    }
+    bit_blocks::combine(blocks(value), blocks(b.value), current_bytes(size_bits), std::bit_xor<uint8_t>());
+    note_all_changed();
     return *this;
 }
 
 BitArray& BitArray::operator<<=(int n) {
     if (n < 0) throw std::invalid_argument("Количество сдвигов не может быть отрицательным");
-    if (n >= size_bits) {
-        reset();
-        return *this;
-    }
-
-    for (int i = 0; i < size_bits - n; ++i) {
-        set(i, operator[](i + n));
-    }
-    for (int i = std::max(size_bits - n, 0); i < size_bits; ++i) {
-        reset(i);
-    }
+    bit_blocks::shift_down(blocks(value), current_bytes(size_bits), n);
+    note_all_changed();
     return *this;
 }
 
 BitArray& BitArray::operator>>=(int n) {
     if (n < 0) throw std::invalid_argument("Количество сдвигов не может быть отрицательным");
-    if (n >= size_bits) {
-        reset();
-        return *this;
-    }
-
-    for (int i = size_bits - 1; i >= n; --i) {
-        set(i, operator[](i - n));
-    }
-    for (int i = 0; i < n && i < size_bits; ++i) {
-        reset(i);
-    }
+    bit_blocks::shift_up(blocks(value), current_bytes(size_bits), n);
+    bit_blocks::fill_range(blocks(value), size_bits, current_bytes(size_bits) * BITS_PER_BYTE, false);
+    note_all_changed();
     return *this;
 }
 
@@ -186,11 +259,13 @@ BitArray& BitArray::set(int n, bool val) {
     } else {
         value[char_index] &= ~(1 << bit_index);
     }
+    note_change(n, n);
     return *this;
 }
 
 BitArray& BitArray::set() {
-    memset(value, 0xFF, (size_bits + 7) / BITS_PER_BYTE);
+    bit_blocks::fill_range(blocks(value), 0, size_bits, true);
+    note_all_changed();
     return *this;
 }
 
@@ -199,15 +274,55 @@ BitArray& BitArray::reset(int n) {
 }
 
 BitArray& BitArray::reset() {
-    memset(value, 0, (size_bits + 7) / BITS_PER_BYTE);
+    bit_blocks::fill_range(blocks(value), 0, size_bits, false);
+    note_all_changed();
     return *this;
 }
 
-bool BitArray::any() const {
-    for (int i = 0; i < (size_bits + 7) / BITS_PER_BYTE; ++i) {
-        if (value[i]) return true;
+void BitArray::test_many(const int* idx, int n, bool* out) const {
+    check_indices(idx, n);
+    for (int i = 0; i < n; ++i) {
+        if (i + PREFETCH_DISTANCE < n) {
+            bit_words::prefetch_read(value + idx[i + PREFETCH_DISTANCE] / BITS_PER_BYTE);
+        }
+        out[i] = (value[idx[i] / BITS_PER_BYTE] >> (idx[i] % BITS_PER_BYTE)) & 1;
     }
-    return false;
+}
+
+void BitArray::set_many(const int* idx, int n, bool val) {
+    check_indices(idx, n);
+    for (int i = 0; i < n; ++i) {
+        if (i + PREFETCH_DISTANCE < n) {
+            bit_words::prefetch_write(value + idx[i + PREFETCH_DISTANCE] / BITS_PER_BYTE);
+        }
+        char mask = static_cast<char>(1 << (idx[i] % BITS_PER_BYTE));
+        if (val) {
+            value[idx[i] / BITS_PER_BYTE] |= mask;
+        } else {
+            value[idx[i] / BITS_PER_BYTE] &= ~mask;
+        }
+        note_change(idx[i], idx[i]);
+    }
+}
+
+void BitArray::reset_many(const int* idx, int n) {
+    set_many(idx, n, false);
+}
+
+void BitArray::flip_many(const int* idx, int n) {
+    check_indices(idx, n);
+    for (int i = 0; i < n; ++i) {
+        if (i + PREFETCH_DISTANCE < n) {
+            bit_words::prefetch_write(value + idx[i + PREFETCH_DISTANCE] / BITS_PER_BYTE);
+        }
+        value[idx[i] / BITS_PER_BYTE] ^= static_cast<char>(1 << (idx[i] % BITS_PER_BYTE));
+        note_change(idx[i], idx[i]);
+    }
+}
+
+bool BitArray::any() const {
+    if (summary) return summary->any();
+    return bit_blocks::any(blocks(value), current_bytes(size_bits));
 }
 
 bool BitArray::none() const {
@@ -216,20 +331,109 @@ bool BitArray::none() const {
 
 BitArray BitArray::operator~() const {
     BitArray result(*this);
-    for (int i = 0; i < (size_bits + 7) / BITS_PER_BYTE; ++i) {
-        result.value[i] = ~value[i];
-    }
+    bit_blocks::invert(blocks(result.value), current_bytes(size_bits));
+    bit_blocks::fill_range(blocks(result.value), size_bits, current_bytes(size_bits) * BITS_PER_BYTE, false);
     return result;
 }
 
 int BitArray::count() const {
     int count = 0;
-    for (int i = 0; i < size_bits; ++i) {
-        count += operator[](i);
+    int full_words = size_bits / bit_words::WORD_BITS;
+    for (int w = 0; w < full_words; ++w) {
+        count += bit_words::popcount64(bit_words::load_u64(value + w * bit_words::WORD_BYTES));
+    }
+    int tail = size_bits - full_words * bit_words::WORD_BITS;
+    if (tail > 0) {
+        uint64_t w = bit_words::load_tail(value, current_bytes(size_bits), full_words * bit_words::WORD_BYTES);
+        count += bit_words::popcount64(w & bit_words::low_mask(tail));
     }
     return count;
 }
 
+int BitArray::find_next(int from) const {
+    if (from < 0) throw std::out_of_range("Выход за границу");
+    if (summary) {
+        if (from >= size_bits) return -1;
+        int w = from / bit_words::WORD_BITS;
+        uint64_t bits = word_at(w) & ~bit_words::low_mask(from % bit_words::WORD_BITS);
+        if (!bits) {
+            w = summary->next_nonempty_word(w + 1);
+            if (w < 0) return -1;
+            bits = word_at(w);
+        }
+        return w * bit_words::WORD_BITS + bit_words::ctz64(bits);
+    }
+    int nbytes = current_bytes(size_bits);
+    int pos = from;
+    while (pos < size_bits) {
+        int byte_index = pos / BITS_PER_BYTE;
+        uint64_t w = bit_words::load_tail(value, nbytes, byte_index) >> (pos % BITS_PER_BYTE);
+        if (w) {
+            int found = pos + bit_words::ctz64(w);
+            return found < size_bits ? found : -1;
+        }
+        pos = byte_index * BITS_PER_BYTE + bit_words::WORD_BITS;
+    }
+    return -1;
+}
+
+int BitArray::find_prev(int from) const {
+    if (from < 0) throw std::out_of_range("Выход за границу");
+    if (from >= size_bits) from = size_bits - 1;
+    if (from < 0) return -1;
+
+    int w = from / bit_words::WORD_BITS;
+    uint64_t bits = word_at(w) & bit_words::low_mask(from % bit_words::WORD_BITS + 1);
+    while (!bits) {
+        w = summary ? summary->prev_nonempty_word(w - 1) : w - 1;
+        if (w < 0) return -1;
+        bits = word_at(w);
+    }
+    return w * bit_words::WORD_BITS + bit_words::floor_log2(bits);
+}
+
+int BitArray::find_next_zero(int from) const {
+    if (from < 0) throw std::out_of_range("Выход за границу");
+    if (from >= size_bits) return -1;
+
+    int nwords = (size_bits + bit_words::WORD_BITS - 1) / bit_words::WORD_BITS;
+    int w = from / bit_words::WORD_BITS;
+    uint64_t zeros = ~word_at(w) & ~bit_words::low_mask(from % bit_words::WORD_BITS);
+    while (true) {
+        int valid = size_bits - w * bit_words::WORD_BITS;
+        zeros &= bit_words::low_mask(valid);
+        if (zeros) return w * bit_words::WORD_BITS + bit_words::ctz64(zeros);
+        w = summary ? summary->next_free_word(w + 1) : w + 1;
+        if (w < 0 || w >= nwords) return -1;
+        zeros = ~word_at(w);
+    }
+}
+
+void BitArray::build_summary() {
+    summary.reset(new BitSummary(*this));
+}
+
+void BitArray::drop_summary() {
+    summary.reset();
+}
+
+bool BitArray::has_summary() const {
+    return summary != nullptr;
+}
+
+int BitArray::find_pattern(const BitArray& needle, int start) const {
+    if (start < 0) throw std::out_of_range("Выход за границу");
+    if (needle.empty()) throw std::invalid_argument("Образец не может быть пустым");
+    return scan_pattern(needle, start, nullptr);
+}
+
+std::vector<int> BitArray::find_all(const BitArray& needle) const {
+    if (needle.empty()) throw std::invalid_argument("Образец не может быть пустым");
+    std::vector<int> result;
+    scan_pattern(needle, 0, &result);
+    return result;
+}
+
 bool BitArray::operator[](int i) const {
     if (i < 0 || i >= size_bits) throw std::out_of_range("Выход за границу");
     int char_index = i / BITS_PER_BYTE;
@@ -253,11 +457,55 @@ std::string BitArray::to_string() const {
     return result;
 }
 
+BitArrayView BitArray::slice(int begin, int end) const {
+    return BitArrayView(value, 0, size_bits).slice(begin, end);
+}
+
+MutableBitArrayView BitArray::mutable_slice(int begin, int end) {
+    MutableBitArrayView result = MutableBitArrayView(value, 0, size_bits).slice(begin, end);
+    result.owner = this;
+    result.owner_begin = begin;
+    return result;
+}
+
+void BitArray::track_changes(bool enable) {
+    tracking = enable;
+    std::vector<uint64_t>().swap(dirty_mask);
+    std::vector<int>().swap(dirty_list);
+}
+
+bool BitArray::tracking_changes() const {
+    return tracking;
+}
+
+std::vector<int> BitArray::dirty_words() const {
+    std::vector<int> result(dirty_list);
+    std::sort(result.begin(), result.end());
+    return result;
+}
+
+void BitArray::checkpoint() {
+    for (int w : dirty_list) {
+        dirty_mask[w / bit_words::WORD_BITS] = 0;
+    }
+    dirty_list.clear();
+}
+
+// Биты за пределами size_bits всегда нулевые вплоть до capacity. Поэтому память
+// берётся уже обнулённой (allocate_zeroed): страницы выделяются системой только при
+// первой записи, а при росте переносятся лишь занятые байты.
 void BitArray::allocate_memory(int size_bits) {
     this->size_bits = size_bits;
     capacity = ((size_bits + 7) / BITS_PER_BYTE) * CAPACITY_MULTIPLIER;
-    value = new char[capacity];
-    memset(value, 0, capacity);
+    value = allocate_zeroed(capacity);
+}
+
+void BitArray::reserve_bytes(int bytes) {
+    if (bytes <= capacity) return;
+    int new_capacity = capacity > INT_MAX / CAPACITY_MULTIPLIER ? bytes
+                                                                : std::max(bytes, capacity * CAPACITY_MULTIPLIER);
+    value = grow_zeroed(value, capacity, current_bytes(size_bits), new_capacity);
+    capacity = new_capacity;
 }
 
 void BitArray::check_size_compatibility(const BitArray& b) const {
@@ -266,6 +514,120 @@ void BitArray::check_size_compatibility(const BitArray& b) const {
     }
 }
 
+uint64_t BitArray::word_at(int w) const {
+    int first_bit = w * bit_words::WORD_BITS;
+    if (first_bit >= size_bits) return 0;
+    uint64_t word = bit_words::load_tail(value, current_bytes(size_bits), w * bit_words::WORD_BYTES);
+    return word & bit_words::low_mask(size_bits - first_bit);
+}
+
+void BitArray::xor_word(int w, uint64_t delta) {
+    int nbytes = current_bytes(size_bits);
+    int byte_index = w * bit_words::WORD_BYTES;
+    uint64_t word = bit_words::load_tail(value, nbytes, byte_index);
+    bit_words::store_tail(value, nbytes, byte_index, word ^ delta);
+    note_change(w * bit_words::WORD_BITS, w * bit_words::WORD_BITS);
+}
+
+void BitArray::note_change(int first_bit, int last_bit) {
+    if (summary) summary->update(*this, first_bit, last_bit);
+    if (!tracking) return;
+    int last_word = last_bit / bit_words::WORD_BITS;
+    if (static_cast<int>(dirty_mask.size()) * bit_words::WORD_BITS <= last_word) {
+        dirty_mask.resize(last_word / bit_words::WORD_BITS + 1, 0);
+    }
+    for (int w = first_bit / bit_words::WORD_BITS; w <= last_word; ++w) {
+        uint64_t& m = dirty_mask[w / bit_words::WORD_BITS];
+        uint64_t bit = uint64_t(1) << (w % bit_words::WORD_BITS);
+        if (!(m & bit)) {
+            m |= bit;
+            dirty_list.push_back(w);
+        }
+    }
+}
+
+void BitArray::note_all_changed() {
+    if (size_bits > 0) note_change(0, size_bits - 1);
+}
+
+void BitArray::check_indices(const int* idx, int n) const {
+    if (n < 0) throw std::invalid_argument("Количество индексов не может быть отрицательным");
+    for (int i = 0; i < n; ++i) {
+        if (idx[i] < 0 || idx[i] >= size_bits) throw std::out_of_range("Выход за границу");
+    }
+}
+
+// Продолжает с шага j проверку 64 позиций слова w сразу: бит i результата остаётся 1,
+// если образец совпадает с массивом с позиции w * 64 + i. На шаге j слово, начинающееся
+// с бита j, сравнивается с маской j-го бита образца; lo и hi - слова w и w + 1.
+uint64_t BitArray::match_block(const std::vector<uint64_t>& masks, int w, int j, uint64_t matches,
+                               uint64_t lo, uint64_t hi) const {
+    int m = static_cast<int>(masks.size());
+    int steps = std::min(m, bit_words::WORD_BITS);
+    for (; j < steps && matches; ++j) {
+        matches &= ~(((lo >> j) | (hi << (bit_words::WORD_BITS - j))) ^ masks[j]);
+    }
+    for (; j < m && matches; ++j) {
+        int k = w + j / bit_words::WORD_BITS;
+        int r = j % bit_words::WORD_BITS;
+        uint64_t window = word_at(k) >> r;
+        if (r) window |= word_at(k + 1) << (bit_words::WORD_BITS - r);
+        matches &= ~(window ^ masks[j]);
+    }
+    return matches;
+}
+
+// Возвращает первое совпадение не раньше start или, если all задан, складывает туда все совпадения.
+int BitArray::scan_pattern(const BitArray& needle, int start, std::vector<int>* all) const {
+    int last = size_bits - needle.size_bits;
+    if (start > last) return -1;
+
+    // Маска шага j: все единицы или все нули в зависимости от бита j образца.
+    std::vector<uint64_t> masks(needle.size_bits);
+    for (int j = 0; j < needle.size_bits; ++j) masks[j] = needle[j] ? ~uint64_t(0) : 0;
+    int prefix = std::min(needle.size_bits, PATTERN_PREFIX_STEPS);
+
+    int nbytes = current_bytes(size_bits);
+    int last_word = last / bit_words::WORD_BITS;
+    uint64_t words[PATTERN_BATCH_WORDS + 1];
+    uint64_t candidates[PATTERN_BATCH_WORDS];
+    for (int first = start / bit_words::WORD_BITS; first <= last_word; first += PATTERN_BATCH_WORDS) {
+        int n = std::min(PATTERN_BATCH_WORDS, last_word - first + 1);
+        for (int i = 0; i <= n; ++i) {
+            int byte = (first + i) * bit_words::WORD_BYTES;
+            words[i] = byte + bit_words::WORD_BYTES <= nbytes
+                ? bit_words::load_u64(value + byte)
+                : bit_words::load_tail(value, nbytes, byte);
+        }
+
+        // Первые шаги идут по всей пачке без ранней проверки, чтобы не было
+        // непредсказуемых ветвлений: внутренний цикл по словам векторизуется.
+        for (int i = 0; i < n; ++i) candidates[i] = ~(words[i] ^ masks[0]);
+        for (int j = 1; j < prefix; ++j) {
+            uint64_t mask = masks[j];
+            for (int i = 0; i < n; ++i) {
+                candidates[i] &= ~(((words[i] >> j) | (words[i + 1] << (bit_words::WORD_BITS - j))) ^ mask);
+            }
+        }
+
+        for (int i = 0; i < n; ++i) {
+            if (!candidates[i]) continue;
+            int w = first + i;
+            uint64_t matches = match_block(masks, w, prefix, candidates[i], words[i], words[i + 1]);
+            int pos = w * bit_words::WORD_BITS;
+            if (pos < start) matches &= ~bit_words::low_mask(start - pos);
+            if (w == last_word) matches &= bit_words::low_mask(last - pos + 1);
+            while (matches) {
+                int found = pos + bit_words::ctz64(matches);
+                if (!all) return found;
+                all->push_back(found);
+                matches &= matches - 1;
+            }
+        }
+    }
+    return -1;
+}
+
 bool operator==(const BitArray& a, const BitArray& b) {
     if (a.size() != b.size()) return false;
     for (int i = 0; i < a.size(); ++i) {
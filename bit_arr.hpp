@@ -1,7 +1,17 @@
 #pragma once
 
+#include <cstdint>
+#include <memory>
 #include <string>
 #include <stdexcept>
+#include <vector>
+
+class BitWriter;
+class BitReader;
+struct BitPatch;
+class BitSummary;
+class BitArrayView;
+class MutableBitArrayView;
 
 class BitArray {
 public:
@@ -32,10 +42,20 @@ public:
     BitArray& reset(int n);
     BitArray& reset();
 
+    void test_many(const int* idx, int n, bool* out) const;
+    void set_many(const int* idx, int n, bool val = true);
+    void reset_many(const int* idx, int n);
+    void flip_many(const int* idx, int n);
+
     bool any() const;
     bool none() const;
     BitArray operator~() const;
     int count() const;
+    int find_next(int from) const;
+    int find_prev(int from) const;
+    int find_next_zero(int from) const;
+    int find_pattern(const BitArray& needle, int start = 0) const;
+    std::vector<int> find_all(const BitArray& needle) const;
 
     bool operator[](int i) const;
     int size() const;
@@ -43,13 +63,46 @@ public:
 
     std::string to_string() const;
 
+    BitArrayView slice(int begin, int end) const;
+    MutableBitArrayView mutable_slice(int begin, int end);
+
+    void track_changes(bool enable = true);
+    bool tracking_changes() const;
+    std::vector<int> dirty_words() const;
+    void checkpoint();
+
+    void build_summary();
+    void drop_summary();
+    bool has_summary() const;
+
 private:
     char* value;        
     int size_bits;      
     int capacity;       
+    bool tracking;
+    std::vector<uint64_t> dirty_mask;
+    std::vector<int> dirty_list;
+    std::unique_ptr<BitSummary> summary;
 
     void allocate_memory(int size_bits);
+    void reserve_bytes(int bytes);
     void check_size_compatibility(const BitArray& b) const;
+    void check_indices(const int* idx, int n) const;
+    int scan_pattern(const BitArray& needle, int start, std::vector<int>* all) const;
+    uint64_t match_block(const std::vector<uint64_t>& masks, int w, int j, uint64_t matches,
+                         uint64_t lo, uint64_t hi) const;
+    uint64_t word_at(int w) const;
+    void xor_word(int w, uint64_t delta);
+    void note_change(int first_bit, int last_bit);
+    void note_all_changed();
+
+    friend class BitWriter;
+    friend class BitReader;
+    friend class BitSummary;
+    friend class MutableBitArrayView;
+    friend BitPatch diff(const BitArray& old_bits, const BitArray& new_bits);
+    friend BitPatch diff_dirty(const BitArray& old_bits, const BitArray& new_bits);
+    friend void apply_patch(BitArray& target, const BitPatch& patch);
 };
 
 bool operator==(const BitArray& a, const BitArray& b);
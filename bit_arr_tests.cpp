@@ -1,5 +1,7 @@
 #include "bit_arr.hpp"
 #include <gtest/gtest.h>
+#include <algorithm>
+#include <vector>
 
 
 TEST(BitArrayTest, DefaultConstructor) {
@@ -79,21 +81,21 @@ TEST(BitArrayTest, BitwiseAND) {
     BitArray b1(8, 0b10101010);
     BitArray b2(8, 0b11001100);
     BitArray result = b1 & b2;
-    EXPECT_EQ(result.to_string(), "01000100");
+    EXPECT_EQ(result.to_string(), "00010001");
 }
 
 TEST(BitArrayTest, BitwiseOR) {
     BitArray b1(8, 0b10101010);
     BitArray b2(8, 0b11001100);
     BitArray result = b1 | b2;
-    EXPECT_EQ(result.to_string(), "11011110");
+    EXPECT_EQ(result.to_string(), "01110111");
 }
 
 TEST(BitArrayTest, BitwiseXOR) {
     BitArray b1(8, 0b10101010);
     BitArray b2(8, 0b11001100);
     BitArray result = b1 ^ b2;
-    EXPECT_EQ(result.to_string(), "10011010");
+    EXPECT_EQ(result.to_string(), "01100110");
 }
 
 TEST(BitArrayTest, BitwiseNOT) {
@@ -106,13 +108,13 @@ TEST(BitArrayTest, BitwiseNOT) {
 TEST(BitArrayTest, LeftShift) {
     BitArray b(8, 0b00001111);
     b <<= 2;
-    EXPECT_EQ(b.to_string(), "00111100");
+    EXPECT_EQ(b.to_string(), "11000000");
 }
 
 TEST(BitArrayTest, RightShift) {
     BitArray b(8, 0b11110000);
     b >>= 2;
-    EXPECT_EQ(b.to_string(), "00111100");
+    EXPECT_EQ(b.to_string(), "00000011");
 }
 
 TEST(BitArrayTest, ShiftBeyondSize) {
@@ -172,6 +174,127 @@ TEST(BitArrayTest, ToString) {
     EXPECT_EQ(b2.to_string(), "10101");
 }
 
+TEST(BitArrayTest, TestMany) {
+    BitArray b(100);
+    b.set(3).set(64).set(99);
+    int idx[] = {99, 0, 64, 3, 3, 50};
+    bool out[6];
+    b.test_many(idx, 6, out);
+    EXPECT_TRUE(out[0]);
+    EXPECT_FALSE(out[1]);
+    EXPECT_TRUE(out[2]);
+    EXPECT_TRUE(out[3]);
+    EXPECT_TRUE(out[4]);
+    EXPECT_FALSE(out[5]);
+}
+
+TEST(BitArrayTest, SetResetFlipMany) {
+    BitArray b(1000);
+    std::vector<int> idx;
+    for (int i = 0; i < 1000; i += 7) idx.push_back(i);
+    b.set_many(idx.data(), static_cast<int>(idx.size()));
+    EXPECT_EQ(b.count(), static_cast<int>(idx.size()));
+    b.reset_many(idx.data(), 10);
+    EXPECT_EQ(b.count(), static_cast<int>(idx.size()) - 10);
+    b.flip_many(idx.data(), static_cast<int>(idx.size()));
+    EXPECT_EQ(b.count(), 10);
+    EXPECT_TRUE(b[0]);
+    EXPECT_FALSE(b[70]);
+}
+
+TEST(BitArrayTest, ManyOutOfRangeLeavesArrayUnchanged) {
+    BitArray b(16);
+    int idx[] = {1, 2, 16};
+    EXPECT_THROW(b.set_many(idx, 3), std::out_of_range);
+    EXPECT_TRUE(b.none());
+    EXPECT_THROW(b.flip_many(idx, -1), std::invalid_argument);
+}
+
+TEST(BitArrayTest, FindPattern) {
+    BitArray hay(200);
+    hay.set(70).set(72).set(73).set(150).set(152).set(153);
+    BitArray needle(4, 0b1101);
+    EXPECT_EQ(hay.find_pattern(needle), 70);
+    EXPECT_EQ(hay.find_pattern(needle, 71), 150);
+    EXPECT_EQ(hay.find_pattern(needle, 151), -1);
+    EXPECT_EQ(hay.find_pattern(BitArray(201)), -1);
+    EXPECT_THROW(hay.find_pattern(BitArray()), std::invalid_argument);
+}
+
+TEST(BitArrayTest, FindAllMatchesNaiveSearch) {
+    const int n = 10000;
+    BitArray hay(n);
+    for (int i = 0; i < n; ++i) hay.set(i, (i * 7919) % 13 < 5);
+    for (int m : {3, 9, 70}) {
+        BitArray needle(m);
+        for (int i = 0; i < m; ++i) needle.set(i, hay[4090 + i]);
+
+        std::vector<int> expected;
+        for (int p = 0; p + m <= n; ++p) {
+            bool ok = true;
+            for (int j = 0; j < m && ok; ++j) ok = hay[p + j] == needle[j];
+            if (ok) expected.push_back(p);
+        }
+        EXPECT_EQ(hay.find_all(needle), expected) << m;
+        auto after = std::upper_bound(expected.begin(), expected.end(), 4090);
+        EXPECT_EQ(hay.find_pattern(needle, 4091), after == expected.end() ? -1 : *after) << m;
+    }
+    EXPECT_EQ(BitArray(8).find_all(BitArray(3)).size(), 6u);
+}
+
+TEST(BitArrayTest, ResizeFillsNewBits) {
+    BitArray b(3, 0b101);
+    b.resize(150, true);
+    EXPECT_EQ(b.count(), 149);
+    EXPECT_FALSE(b[1]);
+    EXPECT_TRUE(b[149]);
+    b.resize(200);
+    EXPECT_EQ(b.count(), 149);
+    EXPECT_FALSE(b[150]);
+}
+
+TEST(BitArrayTest, ShrinkThenGrowGivesZeros) {
+    BitArray b(100);
+    b.set();
+    b.resize(10);
+    b.resize(100);
+    EXPECT_EQ(b.count(), 10);
+
+    BitArray c(13);
+    c = ~c;
+    c.resize(64);
+    EXPECT_EQ(c.count(), 13);
+    c.clear();
+    c.resize(8);
+    EXPECT_TRUE(c.none());
+}
+
+TEST(BitArrayTest, ManyPushBacks) {
+    BitArray b;
+    for (int i = 0; i < 10000; ++i) b.push_back(i % 3 == 0);
+    EXPECT_EQ(b.size(), 10000);
+    EXPECT_EQ(b.count(), 3334);
+    EXPECT_TRUE(b[9999]);
+}
+
+TEST(BitArrayTest, LargeGrowAndCopyKeepBits) {
+    BitArray b(1 << 24);
+    b.set(3).set((1 << 24) - 1);
+    b.resize(1 << 26);
+    b.set((1 << 26) - 1);
+    b.resize((1 << 26) + 100, true);
+    EXPECT_EQ(b.count(), 103);
+    EXPECT_TRUE(b[(1 << 24) - 1]);
+    EXPECT_FALSE(b[1 << 24]);
+
+    BitArray c(b);
+    EXPECT_TRUE(c[3]);
+    EXPECT_TRUE(c[(1 << 26) - 1]);
+    c.resize(1 << 27);
+    EXPECT_EQ(c.count(), 103);
+    EXPECT_EQ(c.find_next((1 << 26) + 100), -1);
+}
+
 
 int main(int argc, char **argv) {
     testing::InitGoogleTest(&argc, argv);
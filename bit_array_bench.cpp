@@ -0,0 +1,55 @@
+#include "basic_bit_array.hpp"
+#include "bit_arr.hpp"
+#include <chrono>
+#include <cstdio>
+
+// Прогоняет одинаковую нагрузку на разных раскладках, чтобы их можно было сравнить напрямую.
+namespace
+{
+    const int BITS = 1 << 22;
+    const int ROUNDS = 20;
+
+    template <typename Array>
+    void run(const char* name)
+    {
+        auto start = std::chrono::steady_clock::now();
+        Array a(BITS);
+        Array b(BITS);
+        for (int i = 0; i < BITS; i += 3) a.set(i);
+        for (int i = 0; i < BITS; i += 5) b.set(i);
+        auto filled = std::chrono::steady_clock::now();
+
+        long checksum = 0;
+        for (int r = 0; r < ROUNDS; ++r) {
+            a ^= b;
+            a |= b;
+            a &= ~b;
+            checksum += a.count();
+        }
+        auto bulk = std::chrono::steady_clock::now();
+
+        for (int r = 0; r < ROUNDS; ++r) {
+            a <<= 13;
+            a >>= 7;
+        }
+        checksum += a.count();
+        auto shifted = std::chrono::steady_clock::now();
+
+        auto ms = [](std::chrono::steady_clock::time_point x, std::chrono::steady_clock::time_point y) {
+            return std::chrono::duration<double, std::milli>(y - x).count();
+        };
+        std::printf("%-18s set %8.2f ms  bulk+count %8.2f ms  shift %8.2f ms  (%ld)\n",
+                    name, ms(start, filled), ms(filled, bulk), ms(bulk, shifted), checksum);
+    }
+}
+
+int main()
+{
+    run<BitArray>("BitArray");
+    run<PackedBitArray8>("PackedBitArray8");
+    run<PackedBitArray32>("PackedBitArray32");
+    run<PackedBitArray64>("PackedBitArray64");
+    run<VectorBitArray>("VectorBitArray");
+    run<InlineBitArray<BITS>>("InlineBitArray");
+    return 0;
+}
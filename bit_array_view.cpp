@@ -0,0 +1,222 @@
+#include "bit_array_view.hpp"
+#include "bit_stream.hpp"
+#include "bit_words.hpp"
+#include <algorithm>
+#include <cstdint>
+
+using bit_words::WORD_BITS;
+
+BitArrayView::BitArrayView() : data(nullptr), offset(0), size_bits(0) {}
+
+BitArrayView::BitArrayView(const void* data, int bit_offset, int size_bits)
+    : data(static_cast<const char*>(data)), offset(0), size_bits(size_bits) {
+    if (bit_offset < 0 || size_bits < 0) throw std::invalid_argument("Смещение и размер не могут быть отрицательными");
+    if (size_bits > 0 && !data) throw std::invalid_argument("Нет памяти под представление");
+    if (data) this->data += bit_offset / 8;
+    offset = bit_offset % 8;
+}
+
+bool BitArrayView::operator[](int i) const {
+    if (i < 0 || i >= size_bits) throw std::out_of_range("Выход за границу");
+    int pos = offset + i;
+    return (data[pos / 8] >> (pos % 8)) & 1;
+}
+
+int BitArrayView::size() const {
+    return size_bits;
+}
+
+bool BitArrayView::empty() const {
+    return size_bits == 0;
+}
+
+bool BitArrayView::any() const {
+    for (int w = 0; w < word_count(); ++w) {
+        if (word(w)) return true;
+    }
+    return false;
+}
+
+bool BitArrayView::none() const {
+    return !any();
+}
+
+int BitArrayView::count() const {
+    int result = 0;
+    for (int w = 0; w < word_count(); ++w) {
+        result += bit_words::popcount64(word(w));
+    }
+    return result;
+}
+
+int BitArrayView::find_next(int from) const {
+    if (from < 0) throw std::out_of_range("Выход за границу");
+    if (from >= size_bits) return -1;
+    int w = from / WORD_BITS;
+    uint64_t bits = word(w) & ~bit_words::low_mask(from % WORD_BITS);
+    while (!bits) {
+        if (++w >= word_count()) return -1;
+        bits = word(w);
+    }
+    return w * WORD_BITS + bit_words::ctz64(bits);
+}
+
+uint64_t BitArrayView::word(int w) const {
+    int first = w * WORD_BITS;
+    if (w < 0 || first >= size_bits) return 0;
+    uint64_t bits = bit_words::load_at_bit(data, byte_count(), offset + first);
+    return bits & bit_words::low_mask(size_bits - first);
+}
+
+int BitArrayView::word_count() const {
+    return (size_bits + WORD_BITS - 1) / WORD_BITS;
+}
+
+BitArrayView BitArrayView::slice(int begin, int end) const {
+    check_slice(begin, end);
+    return BitArrayView(data, offset + begin, end - begin);
+}
+
+BitArray BitArrayView::to_bit_array() const {
+    BitArray result;
+    BitWriter writer(result);
+    for (int w = 0; w < word_count(); ++w) {
+        writer.write_bits(word(w), std::min(WORD_BITS, size_bits - w * WORD_BITS));
+    }
+    writer.flush();
+    return result;
+}
+
+std::string BitArrayView::to_string() const {
+    std::string result(size_bits, '0');
+    for (int i = 0; i < size_bits; ++i) {
+        result[i] = '0' + operator[](i);
+    }
+    return result;
+}
+
+int BitArrayView::byte_count() const {
+    return (offset + size_bits + 7) / 8;
+}
+
+void BitArrayView::check_slice(int begin, int end) const {
+    if (begin < 0 || end > size_bits || begin > end) throw std::out_of_range("Выход за границу");
+}
+
+
+MutableBitArrayView::MutableBitArrayView() : owner(nullptr), owner_begin(0) {}
+
+MutableBitArrayView::MutableBitArrayView(void* data, int bit_offset, int size_bits)
+    : BitArrayView(data, bit_offset, size_bits), owner(nullptr), owner_begin(0) {}
+
+MutableBitArrayView& MutableBitArrayView::set(int n, bool val) {
+    if (n < 0 || n >= size_bits) throw std::out_of_range("Выход за границу");
+    int pos = offset + n;
+    char mask = static_cast<char>(1 << (pos % 8));
+    if (val) {
+        mutable_data()[pos / 8] |= mask;
+    } else {
+        mutable_data()[pos / 8] &= ~mask;
+    }
+    changed(n, n);
+    return *this;
+}
+
+MutableBitArrayView& MutableBitArrayView::set() {
+    for (int w = 0; w < word_count(); ++w) store_word(w, ~uint64_t(0));
+    if (size_bits > 0) changed(0, size_bits - 1);
+    return *this;
+}
+
+MutableBitArrayView& MutableBitArrayView::reset(int n) {
+    return set(n, false);
+}
+
+MutableBitArrayView& MutableBitArrayView::reset() {
+    for (int w = 0; w < word_count(); ++w) store_word(w, 0);
+    if (size_bits > 0) changed(0, size_bits - 1);
+    return *this;
+}
+
+MutableBitArrayView& MutableBitArrayView::flip() {
+    for (int w = 0; w < word_count(); ++w) store_word(w, ~word(w));
+    if (size_bits > 0) changed(0, size_bits - 1);
+    return *this;
+}
+
+// Если приёмник начинается в памяти позже источника, слова обходятся от старших
+// к младшим, как в memmove: иначе запись слова w затрёт биты источника, которые ещё
+// понадобятся для следующих слов.
+template <typename Op>
+void MutableBitArrayView::combine(const BitArrayView& b, Op op) {
+    check_size_compatibility(b);
+    uintptr_t dst = reinterpret_cast<uintptr_t>(data);
+    uintptr_t src = reinterpret_cast<uintptr_t>(b.data);
+    bool backward = dst > src || (dst == src && offset > b.offset);
+    int n = word_count();
+    for (int i = 0; i < n; ++i) {
+        int w = backward ? n - 1 - i : i;
+        store_word(w, op(word(w), b.word(w)));
+    }
+    if (size_bits > 0) changed(0, size_bits - 1);
+}
+
+MutableBitArrayView& MutableBitArrayView::operator&=(const BitArrayView& b) {
+    combine(b, [](uint64_t x, uint64_t y) { return x & y; });
+    return *this;
+}
+
+MutableBitArrayView& MutableBitArrayView::operator|=(const BitArrayView& b) {
+    combine(b, [](uint64_t x, uint64_t y) { return x | y; });
+    return *this;
+}
+
+MutableBitArrayView& MutableBitArrayView::operator^=(const BitArrayView& b) {
+    combine(b, [](uint64_t x, uint64_t y) { return x ^ y; });
+    return *this;
+}
+
+MutableBitArrayView& MutableBitArrayView::assign(const BitArrayView& b) {
+    combine(b, [](uint64_t, uint64_t y) { return y; });
+    return *this;
+}
+
+MutableBitArrayView MutableBitArrayView::slice(int begin, int end) const {
+    check_slice(begin, end);
+    MutableBitArrayView result(mutable_data(), offset + begin, end - begin);
+    result.owner = owner;
+    result.owner_begin = owner_begin + begin;
+    return result;
+}
+
+char* MutableBitArrayView::mutable_data() const {
+    return const_cast<char*>(data);
+}
+
+void MutableBitArrayView::store_word(int w, uint64_t value) {
+    int first = w * WORD_BITS;
+    int len = std::min(WORD_BITS, size_bits - first);
+    bit_words::store_at_bit(mutable_data(), byte_count(), offset + first, value, len);
+}
+
+void MutableBitArrayView::changed(int first_bit, int last_bit) {
+    if (owner) owner->note_change(owner_begin + first_bit, owner_begin + last_bit);
+}
+
+void MutableBitArrayView::check_size_compatibility(const BitArrayView& b) const {
+    if (size_bits != b.size()) {
+        throw std::invalid_argument("Массивы должны иметь одинаковый размер");
+    }
+}
+
+bool operator==(const BitArrayView& a, const BitArrayView& b) {
+    if (a.size() != b.size()) return false;
+    for (int w = 0; w < a.word_count(); ++w) {
+        if (a.word(w) != b.word(w)) return false;
+    }
+    return true;
+}
+
+bool operator!=(const BitArrayView& a, const BitArrayView& b) {
+    return !(a == b);
+}
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include "bit_arr.hpp"
+
+// Невладеющее представление size_bits бит внешней памяти начиная с бита
+// bit_offset байта data. Биты нумеруются так же, как в BitArray: бит i лежит
+// в байте i / 8 на позиции i % 8. Память должна жить дольше представления;
+// представление из BitArray::slice() становится недействительным после изменения размера массива.
+class BitArrayView {
+public:
+    BitArrayView();
+    BitArrayView(const void* data, int bit_offset, int size_bits);
+
+    bool operator[](int i) const;
+    int size() const;
+    bool empty() const;
+
+    bool any() const;
+    bool none() const;
+    int count() const;
+    int find_next(int from) const;
+
+    //64 бита начиная с бита w * 64; биты за концом представления нулевые.
+    uint64_t word(int w) const;
+    int word_count() const;
+
+    BitArrayView slice(int begin, int end) const;
+    BitArray to_bit_array() const;
+    std::string to_string() const;
+
+protected:
+    const char* data;
+    int offset;
+    int size_bits;
+
+    int byte_count() const;
+    void check_slice(int begin, int end) const;
+
+    friend class MutableBitArrayView;
+};
+
+// Представление, через которое можно менять биты. Если оно получено из
+// BitArray::mutable_slice(), изменения видны отслеживанию изменений и сводке массива.
+class MutableBitArrayView : public BitArrayView {
+public:
+    MutableBitArrayView();
+    MutableBitArrayView(void* data, int bit_offset, int size_bits);
+
+    MutableBitArrayView& set(int n, bool val = true);
+    MutableBitArrayView& set();
+    MutableBitArrayView& reset(int n);
+    MutableBitArrayView& reset();
+    MutableBitArrayView& flip();
+
+    MutableBitArrayView& operator&=(const BitArrayView& b);
+    MutableBitArrayView& operator|=(const BitArrayView& b);
+    MutableBitArrayView& operator^=(const BitArrayView& b);
+    //Копирует биты b того же размера. Как и у побитовых операций выше, b может
+    //перекрываться с этим представлением в той же памяти.
+    MutableBitArrayView& assign(const BitArrayView& b);
+
+    MutableBitArrayView slice(int begin, int end) const;
+
+private:
+    BitArray* owner;
+    int owner_begin;
+
+    char* mutable_data() const;
+    void store_word(int w, uint64_t value);
+    template <typename Op>
+    void combine(const BitArrayView& b, Op op);
+    void changed(int first_bit, int last_bit);
+    void check_size_compatibility(const BitArrayView& b) const;
+
+    friend class BitArray;
+};
+
+bool operator==(const BitArrayView& a, const BitArrayView& b);
+bool operator!=(const BitArrayView& a, const BitArrayView& b);
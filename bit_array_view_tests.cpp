@@ -0,0 +1,97 @@
+#include "bit_array_view.hpp"
+#include <gtest/gtest.h>
+
+
+TEST(BitArrayViewTest, SliceReadsWithoutCopy) {
+    BitArray b(200);
+    b.set(3).set(70).set(71).set(199);
+    BitArrayView v = b.slice(3, 200);
+    EXPECT_EQ(v.size(), 197);
+    EXPECT_TRUE(v[0]);
+    EXPECT_TRUE(v[67]);
+    EXPECT_EQ(v.count(), 4);
+    EXPECT_EQ(v.find_next(1), 67);
+
+    b.set(100);
+    EXPECT_TRUE(v[97]);
+    EXPECT_EQ(v.slice(1, 60).count(), 0);
+    EXPECT_EQ(v.slice(60, 70).to_string(), "0000000110");
+    EXPECT_THROW(b.slice(5, 201), std::out_of_range);
+}
+
+TEST(BitArrayViewTest, ExternalUnalignedMemory) {
+    unsigned char buf[20] = {};
+    buf[2] = 0xF0;
+    buf[11] = 0x01;
+    BitArrayView v(buf, 13, 100);
+    EXPECT_EQ(v.count(), 5);
+    EXPECT_EQ(v.find_next(0), 7);
+    EXPECT_EQ(v.find_next(11), 88 - 13);
+    EXPECT_EQ(v.to_bit_array().to_string(), v.to_string());
+}
+
+TEST(BitArrayViewTest, MutableOperationsStayInside) {
+    unsigned char buf[16];
+    for (unsigned char& c : buf) c = 0xAA;
+    MutableBitArrayView v(buf, 5, 100);
+    v.reset();
+    EXPECT_TRUE(v.none());
+    EXPECT_EQ(buf[0], 0x0A);
+    EXPECT_EQ(buf[12], 0x00);
+    EXPECT_EQ(buf[13], 0xAA);
+
+    v.set(0).set(99);
+    v.flip();
+    EXPECT_EQ(v.count(), 98);
+    EXPECT_EQ(buf[12], 0xFF);
+    EXPECT_EQ(buf[13], 0xAA);
+}
+
+TEST(BitArrayViewTest, BulkOperationsBetweenViews) {
+    BitArray a(300);
+    BitArray b(300);
+    for (int i = 0; i < 300; i += 3) a.set(i);
+    for (int i = 0; i < 300; i += 5) b.set(i);
+
+    MutableBitArrayView dst = a.mutable_slice(7, 207);
+    BitArrayView src = b.slice(50, 250);
+    BitArray expected = a.slice(7, 207).to_bit_array() ^ src.to_bit_array();
+    dst ^= src;
+    EXPECT_EQ(dst.to_bit_array(), expected);
+    EXPECT_EQ(a.slice(0, 7).to_string(), "1001001");
+
+    dst.assign(src);
+    EXPECT_EQ(dst, src);
+    EXPECT_THROW(dst &= b.slice(0, 10), std::invalid_argument);
+}
+
+TEST(BitArrayViewTest, OverlappingViewsInSameArray) {
+    BitArray base(400);
+    for (int i = 0; i < 400; ++i) base.set(i, (i * 37) % 11 < 4);
+
+    for (int shift : {1, 63, 64, 130}) {
+        BitArray a(base);
+        BitArray copied = a.slice(0, 250).to_bit_array();
+        a.mutable_slice(shift, 250 + shift).assign(a.slice(0, 250));
+        EXPECT_EQ(a.slice(shift, 250 + shift).to_bit_array(), copied) << shift;
+
+        BitArray b(base);
+        BitArray xored = b.slice(shift, 250 + shift).to_bit_array() ^ b.slice(0, 250).to_bit_array();
+        b.mutable_slice(shift, 250 + shift) ^= b.slice(0, 250);
+        EXPECT_EQ(b.slice(shift, 250 + shift).to_bit_array(), xored) << shift;
+
+        BitArray c(base);
+        copied = c.slice(shift, 250 + shift).to_bit_array();
+        c.mutable_slice(0, 250).assign(c.slice(shift, 250 + shift));
+        EXPECT_EQ(c.slice(0, 250).to_bit_array(), copied) << shift;
+    }
+}
+
+TEST(BitArrayViewTest, MutableSliceUpdatesSummaryAndDirtyWords) {
+    BitArray a(1000);
+    a.build_summary();
+    a.track_changes();
+    a.mutable_slice(500, 1000).set(200);
+    EXPECT_EQ(a.find_next(0), 700);
+    EXPECT_EQ(a.dirty_words(), std::vector<int>{10});
+}
@@ -0,0 +1,83 @@
+#include "bit_diff.hpp"
+#include "bit_words.hpp"
+#include <algorithm>
+
+namespace
+{
+    int words_for(int size_bits)
+    {
+        return (size_bits + bit_words::WORD_BITS - 1) / bit_words::WORD_BITS;
+    }
+
+    void append_delta(BitPatch& patch, int w, uint64_t delta)
+    {
+        if (!delta) return;
+        if (patch.runs.empty() ||
+            patch.runs.back().first_word + static_cast<int>(patch.runs.back().deltas.size()) != w) {
+            patch.runs.push_back(BitPatchRun{w, {}});
+        }
+        patch.runs.back().deltas.push_back(delta);
+    }
+}
+
+bool BitPatch::empty() const {
+    return old_size == new_size && runs.empty();
+}
+
+int BitPatch::changed_words() const {
+    int result = 0;
+    for (const BitPatchRun& run : runs) {
+        result += static_cast<int>(run.deltas.size());
+    }
+    return result;
+}
+
+BitPatch diff(const BitArray& old_bits, const BitArray& new_bits) {
+    BitPatch patch;
+    patch.old_size = old_bits.size_bits;
+    patch.new_size = new_bits.size_bits;
+    int nwords = words_for(std::max(old_bits.size_bits, new_bits.size_bits));
+    for (int w = 0; w < nwords; ++w) {
+        append_delta(patch, w, old_bits.word_at(w) ^ new_bits.word_at(w));
+    }
+    return patch;
+}
+
+BitPatch diff_dirty(const BitArray& old_bits, const BitArray& new_bits) {
+    if (!new_bits.tracking) throw std::invalid_argument("Отслеживание изменений не включено");
+
+    std::vector<int> words = new_bits.dirty_words();
+    if (old_bits.size_bits != new_bits.size_bits) {
+        int from = std::min(old_bits.size_bits, new_bits.size_bits) / bit_words::WORD_BITS;
+        int to = words_for(std::max(old_bits.size_bits, new_bits.size_bits));
+        for (int w = from; w < to; ++w) words.push_back(w);
+        std::sort(words.begin(), words.end());
+        words.erase(std::unique(words.begin(), words.end()), words.end());
+    }
+
+    BitPatch patch;
+    patch.old_size = old_bits.size_bits;
+    patch.new_size = new_bits.size_bits;
+    for (int w : words) {
+        append_delta(patch, w, old_bits.word_at(w) ^ new_bits.word_at(w));
+    }
+    return patch;
+}
+
+void apply_patch(BitArray& target, const BitPatch& patch) {
+    if (target.size_bits != patch.old_size) throw std::invalid_argument("Патч не подходит к массиву");
+    int nwords = words_for(std::max(patch.old_size, patch.new_size));
+    for (const BitPatchRun& run : patch.runs) {
+        if (run.first_word < 0 || run.first_word + static_cast<int>(run.deltas.size()) > nwords) {
+            throw std::invalid_argument("Патч не подходит к массиву");
+        }
+    }
+
+    if (patch.new_size > patch.old_size) target.resize(patch.new_size);
+    for (const BitPatchRun& run : patch.runs) {
+        for (size_t i = 0; i < run.deltas.size(); ++i) {
+            target.xor_word(run.first_word + static_cast<int>(i), run.deltas[i]);
+        }
+    }
+    if (patch.new_size < patch.old_size) target.resize(patch.new_size);
+}
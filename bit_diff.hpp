@@ -0,0 +1,31 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include "bit_arr.hpp"
+
+// Подряд идущие изменённые 64-битные слова: deltas[i] = старое ^ новое
+// для слова first_word + i.
+struct BitPatchRun {
+    int first_word;
+    std::vector<uint64_t> deltas;
+};
+
+// Разница между двумя версиями массива. Слова без изменений не хранятся,
+// поэтому размер патча пропорционален объёму изменений.
+struct BitPatch {
+    int old_size = 0;
+    int new_size = 0;
+    std::vector<BitPatchRun> runs;
+
+    bool empty() const;
+    int changed_words() const;
+};
+
+//Сравнивает массивы целиком.
+BitPatch diff(const BitArray& old_bits, const BitArray& new_bits);
+//Сравнивает только слова, изменённые в new_bits с последнего checkpoint().
+//old_bits должен совпадать с new_bits на момент checkpoint().
+BitPatch diff_dirty(const BitArray& old_bits, const BitArray& new_bits);
+//Превращает массив размера patch.old_size в новую версию.
+void apply_patch(BitArray& target, const BitPatch& patch);
@@ -0,0 +1,76 @@
+#include "bit_diff.hpp"
+#include <gtest/gtest.h>
+
+
+TEST(BitDiffTest, RoundTrip) {
+    BitArray old_bits(10000);
+    for (int i = 0; i < 10000; i += 3) old_bits.set(i);
+    BitArray new_bits(old_bits);
+    new_bits.reset(3).set(700).set(701).set(9998);
+
+    BitPatch patch = diff(old_bits, new_bits);
+    EXPECT_EQ(patch.changed_words(), 3);
+    EXPECT_EQ(patch.runs.size(), 3u);
+
+    apply_patch(old_bits, patch);
+    EXPECT_EQ(old_bits, new_bits);
+}
+
+TEST(BitDiffTest, AdjacentWordsFormOneRun) {
+    BitArray old_bits(512);
+    BitArray new_bits(512);
+    for (int i = 64; i < 256; i += 10) new_bits.set(i);
+    BitPatch patch = diff(old_bits, new_bits);
+    ASSERT_EQ(patch.runs.size(), 1u);
+    EXPECT_EQ(patch.runs[0].first_word, 1);
+    EXPECT_EQ(patch.runs[0].deltas.size(), 3u);
+    EXPECT_TRUE(diff(new_bits, new_bits).empty());
+}
+
+TEST(BitDiffTest, SizeChange) {
+    BitArray small(70, 0b1011);
+    BitArray big(200);
+    big.set(1).set(150);
+
+    BitArray target(small);
+    apply_patch(target, diff(small, big));
+    EXPECT_EQ(target, big);
+
+    apply_patch(target, diff(big, small));
+    EXPECT_EQ(target, small);
+    EXPECT_THROW(apply_patch(target, diff(big, small)), std::invalid_argument);
+}
+
+TEST(BitDiffTest, DirtyTracking) {
+    BitArray live(1000);
+    live.track_changes();
+    live.set(5).set(6).set(640);
+    int idx[] = {999};
+    live.set_many(idx, 1);
+    EXPECT_EQ(live.dirty_words(), (std::vector<int>{0, 10, 15}));
+
+    live.checkpoint();
+    EXPECT_TRUE(live.dirty_words().empty());
+
+    live.reset();
+    EXPECT_EQ(live.dirty_words().size(), 16u);
+}
+
+TEST(BitDiffTest, DiffDirtyMatchesFullDiff) {
+    BitArray live(5000);
+    for (int i = 0; i < 5000; i += 11) live.set(i);
+    live.track_changes();
+    BitArray shadow(live);
+
+    live.set(1).reset(11).set(4097);
+    live.resize(5100, true);
+
+    BitPatch patch = diff_dirty(shadow, live);
+    EXPECT_EQ(patch.changed_words(), diff(shadow, live).changed_words());
+    apply_patch(shadow, patch);
+    EXPECT_EQ(shadow, live);
+
+    live.checkpoint();
+    EXPECT_TRUE(diff_dirty(shadow, live).empty());
+    EXPECT_THROW(diff_dirty(live, shadow), std::invalid_argument);
+}
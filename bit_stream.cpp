@@ -0,0 +1,182 @@
+#include "bit_stream.hpp"
+#include "bit_words.hpp"
+#include <algorithm>
+
+using bit_words::WORD_BITS;
+using bit_words::WORD_BYTES;
+
+BitWriter::BitWriter(BitArray& out) : out(out), acc(0), filled(0) {
+    word_start = out.size_bits / WORD_BITS * WORD_BITS;
+    filled = out.size_bits - word_start;
+    if (filled > 0) {
+        int nbytes = (out.size_bits + 7) / 8;
+        acc = bit_words::load_tail(out.value, nbytes, word_start / 8) & bit_words::low_mask(filled);
+    }
+}
+
+BitWriter::~BitWriter() {
+    try {
+        flush();
+    } catch (...) {
+    }
+}
+
+void BitWriter::write_bits(uint64_t value, int k) {
+    if (k < 0 || k > WORD_BITS) throw std::invalid_argument("Можно записать от 0 до 64 бит");
+    if (k == 0) return;
+    value &= bit_words::low_mask(k);
+
+    acc |= value << filled;
+    if (filled + k < WORD_BITS) {
+        filled += k;
+        return;
+    }
+
+    store_acc();
+    int used = WORD_BITS - filled;
+    acc = used < WORD_BITS ? value >> used : 0;
+    filled = k - used;
+    word_start += WORD_BITS;
+}
+
+void BitWriter::write_bit(bool bit) {
+    write_bits(bit, 1);
+}
+
+void BitWriter::write_unary(uint64_t n) {
+    while (n >= static_cast<uint64_t>(WORD_BITS)) {
+        write_bits(0, WORD_BITS);
+        n -= WORD_BITS;
+    }
+    write_bits(uint64_t(1) << n, static_cast<int>(n) + 1);
+}
+
+void BitWriter::write_gamma(uint64_t x) {
+    if (x == 0) throw std::invalid_argument("Гамма-код определён только для x >= 1");
+    int n = bit_words::floor_log2(x);
+    if (2 * n + 1 <= WORD_BITS) {
+        uint64_t low = x & bit_words::low_mask(n);
+        write_bits((low << (n + 1)) | (uint64_t(1) << n), 2 * n + 1);
+        return;
+    }
+    write_unary(n);
+    write_bits(x, n);
+}
+
+void BitWriter::write_delta(uint64_t x) {
+    if (x == 0) throw std::invalid_argument("Дельта-код определён только для x >= 1");
+    int n = bit_words::floor_log2(x);
+    write_gamma(n + 1);
+    write_bits(x, n);
+}
+
+void BitWriter::write_rice(uint64_t value, int k) {
+    if (k < 0 || k > WORD_BITS) throw std::invalid_argument("Параметр Райса должен быть от 0 до 64");
+    write_unary(k == WORD_BITS ? 0 : value >> k);
+    write_bits(value, k);
+}
+
+void BitWriter::flush() {
+    if (filled == 0) return;
+    int bytes = (filled + 7) / 8;
+    out.reserve_bytes(word_start / 8 + bytes);
+    char* p = out.value + word_start / 8;
+    for (int b = 0; b < bytes; ++b) {
+        p[b] = static_cast<char>(acc >> (8 * b));
+    }
+    out.size_bits = word_start + filled;
+    out.note_change(word_start, word_start + filled - 1);
+}
+
+int BitWriter::position() const {
+    return word_start + filled;
+}
+
+void BitWriter::store_acc() {
+    out.reserve_bytes(word_start / 8 + WORD_BYTES);
+    bit_words::store_u64(out.value + word_start / 8, acc);
+    out.size_bits = word_start + WORD_BITS;
+    out.note_change(word_start, word_start + WORD_BITS - 1);
+}
+
+
+BitReader::BitReader(const BitArray& in, int start)
+    : data(in.value), nbytes((in.size_bits + 7) / 8), size_bits(in.size_bits), pos(start) {
+    if (start < 0 || start > size_bits) throw std::out_of_range("Выход за границу");
+}
+
+uint64_t BitReader::read_bits(int k) {
+    uint64_t result = peek(k);
+    pos += k;
+    return result;
+}
+
+bool BitReader::read_bit() {
+    return read_bits(1);
+}
+
+uint64_t BitReader::peek(int k) const {
+    if (k < 0 || k > WORD_BITS) throw std::invalid_argument("Можно прочитать от 0 до 64 бит");
+    if (k > size_bits - pos) throw std::out_of_range("Выход за границу");
+    if (k == 0) return 0;
+
+    int byte_index = pos / 8;
+    int offset = pos % 8;
+    uint64_t w = bit_words::load_tail(data, nbytes, byte_index) >> offset;
+    if (offset + k > WORD_BITS) {
+        w |= bit_words::load_tail(data, nbytes, byte_index + WORD_BYTES) << (WORD_BITS - offset);
+    }
+    return w & bit_words::low_mask(k);
+}
+
+void BitReader::skip(int k) {
+    if (k < 0 || k > size_bits - pos) throw std::out_of_range("Выход за границу");
+    pos += k;
+}
+
+uint64_t BitReader::read_unary() {
+    uint64_t n = 0;
+    while (true) {
+        int chunk = std::min(WORD_BITS, size_bits - pos);
+        if (chunk == 0) throw std::out_of_range("Неожиданный конец потока");
+        uint64_t w = peek(chunk);
+        if (w) {
+            int zeros = bit_words::ctz64(w);
+            pos += zeros + 1;
+            return n + zeros;
+        }
+        n += chunk;
+        pos += chunk;
+    }
+}
+
+uint64_t BitReader::read_gamma() {
+    uint64_t n = read_unary();
+    if (n >= static_cast<uint64_t>(WORD_BITS)) throw std::invalid_argument("Некорректный гамма-код");
+    return (uint64_t(1) << n) | read_bits(static_cast<int>(n));
+}
+
+uint64_t BitReader::read_delta() {
+    uint64_t n = read_gamma() - 1;
+    if (n >= static_cast<uint64_t>(WORD_BITS)) throw std::invalid_argument("Некорректный дельта-код");
+    return (uint64_t(1) << n) | read_bits(static_cast<int>(n));
+}
+
+uint64_t BitReader::read_rice(int k) {
+    if (k < 0 || k > WORD_BITS) throw std::invalid_argument("Параметр Райса должен быть от 0 до 64");
+    uint64_t q = read_unary();
+    uint64_t r = read_bits(k);
+    return k == WORD_BITS ? r : (q << k) | r;
+}
+
+int BitReader::position() const {
+    return pos;
+}
+
+int BitReader::remaining() const {
+    return size_bits - pos;
+}
+
+bool BitReader::at_end() const {
+    return pos == size_bits;
+}
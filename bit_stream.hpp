@@ -0,0 +1,72 @@
+#pragma once
+
+#include <cstdint>
+#include "bit_arr.hpp"
+
+// Дописывает k-битные значения в конец BitArray словами по 64 бита.
+// Биты значения укладываются начиная с младшего.
+// Размер массива становится точным после flush() или разрушения писателя.
+// Деструктор не бросает исключений: если при дозаписи не хватит памяти, хвост
+// потеряется молча, поэтому там, где это важно, flush() нужно вызвать явно.
+class BitWriter {
+public:
+    explicit BitWriter(BitArray& out);
+    ~BitWriter();
+
+    BitWriter(const BitWriter&) = delete;
+    BitWriter& operator=(const BitWriter&) = delete;
+
+    //Записывает k младших бит value, 0 <= k <= 64.
+    void write_bits(uint64_t value, int k);
+    void write_bit(bool bit);
+    //n нулей, затем единица.
+    void write_unary(uint64_t n);
+    //Гамма-код Элиаса, x >= 1.
+    void write_gamma(uint64_t x);
+    //Дельта-код Элиаса, x >= 1.
+    void write_delta(uint64_t x);
+    //Код Голомба-Райса с параметром k: частное в унарном коде, затем k бит остатка.
+    void write_rice(uint64_t value, int k);
+
+    //Сбрасывает накопленные биты в массив и выставляет его точный размер.
+    void flush();
+    //Количество бит в массиве с учётом ещё не сброшенных.
+    int position() const;
+
+private:
+    BitArray& out;
+    uint64_t acc;
+    int filled;
+    int word_start;
+
+    void store_acc();
+};
+
+// Читает биты из BitArray начиная с заданной позиции.
+// Массив не должен изменяться, пока с ним работает читатель.
+class BitReader {
+public:
+    explicit BitReader(const BitArray& in, int start = 0);
+
+    //Возвращает следующие k бит, 0 <= k <= 64, и сдвигает позицию.
+    uint64_t read_bits(int k);
+    bool read_bit();
+    //Возвращает следующие k бит, не сдвигая позицию.
+    uint64_t peek(int k) const;
+    void skip(int k);
+
+    uint64_t read_unary();
+    uint64_t read_gamma();
+    uint64_t read_delta();
+    uint64_t read_rice(int k);
+
+    int position() const;
+    int remaining() const;
+    bool at_end() const;
+
+private:
+    const char* data;
+    int nbytes;
+    int size_bits;
+    int pos;
+};
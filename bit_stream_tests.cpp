@@ -0,0 +1,97 @@
+#include "bit_stream.hpp"
+#include <gtest/gtest.h>
+#include <vector>
+
+
+TEST(BitStreamTest, FixedWidthRoundTrip) {
+    BitArray b;
+    {
+        BitWriter w(b);
+        for (int k = 1; k <= 64; ++k) {
+            w.write_bits(0x9E3779B97F4A7C15ull, k);
+        }
+    }
+    EXPECT_EQ(b.size(), 64 * 65 / 2);
+
+    BitReader r(b);
+    for (int k = 1; k <= 64; ++k) {
+        uint64_t mask = k == 64 ? ~0ull : ((1ull << k) - 1);
+        EXPECT_EQ(r.read_bits(k), 0x9E3779B97F4A7C15ull & mask);
+    }
+    EXPECT_TRUE(r.at_end());
+}
+
+TEST(BitStreamTest, AppendsAfterExistingBits) {
+    BitArray b(5, 0b10110);
+    {
+        BitWriter w(b);
+        w.write_bits(0b011, 3);
+    }
+    EXPECT_EQ(b.to_string(), "01101110");
+}
+
+TEST(BitStreamTest, MatchesOperatorIndex) {
+    BitArray b;
+    BitWriter w(b);
+    w.write_bits(0xF0F0F0F0F0F0F0F0ull, 64);
+    w.write_bits(0b101, 3);
+    w.flush();
+    ASSERT_EQ(b.size(), 67);
+    for (int i = 0; i < 64; ++i) EXPECT_EQ(b[i], ((0xF0F0F0F0F0F0F0F0ull >> i) & 1) != 0);
+    EXPECT_TRUE(b[64]);
+    EXPECT_FALSE(b[65]);
+    EXPECT_TRUE(b[66]);
+}
+
+TEST(BitStreamTest, GammaDeltaRiceRoundTrip) {
+    std::vector<uint64_t> values = {1, 2, 3, 7, 8, 100, 1000, 123456789, (1ull << 40) + 5, ~0ull};
+    BitArray b;
+    {
+        BitWriter w(b);
+        for (uint64_t v : values) w.write_gamma(v);
+        for (uint64_t v : values) w.write_delta(v);
+        for (uint64_t v : values) w.write_rice(v % 5000, 6);
+    }
+
+    BitReader r(b);
+    for (uint64_t v : values) EXPECT_EQ(r.read_gamma(), v);
+    for (uint64_t v : values) EXPECT_EQ(r.read_delta(), v);
+    for (uint64_t v : values) EXPECT_EQ(r.read_rice(6), v % 5000);
+    EXPECT_TRUE(r.at_end());
+}
+
+TEST(BitStreamTest, LongUnary) {
+    BitArray b;
+    {
+        BitWriter w(b);
+        w.write_unary(200);
+        w.write_unary(0);
+    }
+    EXPECT_EQ(b.size(), 202);
+    BitReader r(b);
+    EXPECT_EQ(r.read_unary(), 200u);
+    EXPECT_EQ(r.read_unary(), 0u);
+}
+
+TEST(BitStreamTest, PeekAndSkip) {
+    BitArray b(16, 0xABCD);
+    BitReader r(b, 4);
+    EXPECT_EQ(r.peek(8), 0xBCu);
+    EXPECT_EQ(r.position(), 4);
+    r.skip(4);
+    EXPECT_EQ(r.read_bits(8), 0xABu);
+    EXPECT_EQ(r.remaining(), 0);
+}
+
+TEST(BitStreamTest, InvalidArguments) {
+    BitArray b(8);
+    BitReader r(b);
+    EXPECT_THROW(r.read_bits(9), std::out_of_range);
+    EXPECT_THROW(r.skip(9), std::out_of_range);
+    EXPECT_THROW(r.read_unary(), std::out_of_range);
+    EXPECT_THROW(BitReader(b, 9), std::out_of_range);
+
+    BitWriter w(b);
+    EXPECT_THROW(w.write_gamma(0), std::invalid_argument);
+    EXPECT_THROW(w.write_bits(1, 65), std::invalid_argument);
+}
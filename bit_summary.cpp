@@ -0,0 +1,115 @@
+#include "bit_summary.hpp"
+#include "bit_words.hpp"
+#include <algorithm>
+
+using bit_words::WORD_BITS;
+
+namespace
+{
+    int words_for(int n)
+    {
+        return (n + WORD_BITS - 1) / WORD_BITS;
+    }
+
+    void assign_bit(std::vector<uint64_t>& level, int i, bool val)
+    {
+        uint64_t mask = uint64_t(1) << (i % WORD_BITS);
+        if (val) {
+            level[i / WORD_BITS] |= mask;
+        } else {
+            level[i / WORD_BITS] &= ~mask;
+        }
+    }
+}
+
+BitSummary::BitSummary(const BitArray& bits) {
+    reserve_words(std::max(words_for(bits.size_bits), 1));
+    if (bits.size_bits > 0) update(bits, 0, bits.size_bits - 1);
+}
+
+void BitSummary::update(const BitArray& bits, int first_bit, int last_bit) {
+    int first_word = first_bit / WORD_BITS;
+    int last_word = last_bit / WORD_BITS;
+    reserve_words(std::max(last_word + 1, words_for(bits.size_bits)));
+
+    for (int w = first_word; w <= last_word; ++w) {
+        uint64_t word = bits.word_at(w);
+        int valid = std::min(bits.size_bits - w * WORD_BITS, WORD_BITS);
+        bool has_zero = valid > 0 && (~word & bit_words::low_mask(valid)) != 0;
+        assign_bit(nonempty[0], w, word != 0);
+        assign_bit(nonfull[0], w, has_zero);
+    }
+    propagate(nonempty, first_word, last_word);
+    propagate(nonfull, first_word, last_word);
+}
+
+bool BitSummary::any() const {
+    return nonempty.back()[0] != 0;
+}
+
+int BitSummary::next_nonempty_word(int w) const {
+    return next_in_level(nonempty, 0, std::max(w, 0));
+}
+
+int BitSummary::prev_nonempty_word(int w) const {
+    return prev_in_level(nonempty, 0, w);
+}
+
+int BitSummary::next_free_word(int w) const {
+    return next_in_level(nonfull, 0, std::max(w, 0));
+}
+
+void BitSummary::reserve_words(int nwords) {
+    if (!nonempty.empty() && static_cast<int>(nonempty[0].size()) * WORD_BITS >= nwords) return;
+
+    int bottom = words_for(nwords);
+    if (!nonempty.empty()) bottom = std::max(bottom, static_cast<int>(nonempty[0].size()) * 2);
+    std::vector<int> sizes(1, bottom);
+    while (sizes.back() > 1) sizes.push_back(words_for(sizes.back()));
+
+    for (Levels* levels : {&nonempty, &nonfull}) {
+        levels->resize(sizes.size());
+        for (size_t k = 0; k < sizes.size(); ++k) {
+            (*levels)[k].resize(sizes[k], 0);
+        }
+        propagate(*levels, 0, bottom * WORD_BITS - 1);
+    }
+}
+
+// Бит p уровня k + 1 равен 1, если слово p уровня k ненулевое.
+void BitSummary::propagate(Levels& levels, int first, int last) {
+    for (size_t k = 0; k + 1 < levels.size(); ++k) {
+        first /= WORD_BITS;
+        last /= WORD_BITS;
+        for (int p = first; p <= last; ++p) {
+            assign_bit(levels[k + 1], p, levels[k][p] != 0);
+        }
+    }
+}
+
+int BitSummary::next_in_level(const Levels& levels, int k, int pos) {
+    if (k >= static_cast<int>(levels.size())) return -1;
+    int word = pos / WORD_BITS;
+    if (word >= static_cast<int>(levels[k].size())) return -1;
+
+    uint64_t m = levels[k][word] & ~bit_words::low_mask(pos % WORD_BITS);
+    if (m) return word * WORD_BITS + bit_words::ctz64(m);
+
+    int up = next_in_level(levels, k + 1, word + 1);
+    if (up < 0) return -1;
+    return up * WORD_BITS + bit_words::ctz64(levels[k][up]);
+}
+
+int BitSummary::prev_in_level(const Levels& levels, int k, int pos) {
+    if (pos < 0 || k >= static_cast<int>(levels.size())) return -1;
+    int size = static_cast<int>(levels[k].size());
+    if (pos >= size * WORD_BITS) pos = size * WORD_BITS - 1;
+    int word = pos / WORD_BITS;
+
+    uint64_t m = levels[k][word] & bit_words::low_mask(pos % WORD_BITS + 1);
+    if (m) return word * WORD_BITS + bit_words::floor_log2(m);
+
+    int up = prev_in_level(levels, k + 1, word - 1);
+    if (up < 0) return -1;
+    return up * WORD_BITS + bit_words::floor_log2(levels[k][up]);
+}
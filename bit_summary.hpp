@@ -0,0 +1,37 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include "bit_arr.hpp"
+
+// Иерархическая сводка над словами BitArray. На нижнем уровне один бит на
+// каждое 64-битное слово массива, на каждом следующем — один бит на слово
+// предыдущего уровня, и так до одного корневого слова. Поддерживаются две
+// иерархии: «в слове есть единица» и «в слове есть ноль». Поиск соседнего
+// непустого или незаполненного слова занимает O(log64 n) операций.
+class BitSummary {
+public:
+    explicit BitSummary(const BitArray& bits);
+
+    //Пересчитывает сводку для слов, содержащих биты first_bit..last_bit.
+    void update(const BitArray& bits, int first_bit, int last_bit);
+
+    bool any() const;
+    //Первое непустое слово с индексом >= w, или -1.
+    int next_nonempty_word(int w) const;
+    //Последнее непустое слово с индексом <= w, или -1.
+    int prev_nonempty_word(int w) const;
+    //Первое слово с индексом >= w, в котором есть нулевой бит, или -1.
+    int next_free_word(int w) const;
+
+private:
+    typedef std::vector<std::vector<uint64_t>> Levels;
+
+    Levels nonempty;
+    Levels nonfull;
+
+    void reserve_words(int nwords);
+    static void propagate(Levels& levels, int first, int last);
+    static int next_in_level(const Levels& levels, int k, int pos);
+    static int prev_in_level(const Levels& levels, int k, int pos);
+};
@@ -0,0 +1,71 @@
+#include "bit_summary.hpp"
+#include <gtest/gtest.h>
+
+
+TEST(BitSummaryTest, NextAndPrevSetBit) {
+    BitArray b(1 << 20);
+    b.build_summary();
+    EXPECT_FALSE(b.any());
+    EXPECT_EQ(b.find_next(0), -1);
+
+    b.set(5).set(300000).set((1 << 20) - 1);
+    EXPECT_TRUE(b.any());
+    EXPECT_EQ(b.find_next(0), 5);
+    EXPECT_EQ(b.find_next(6), 300000);
+    EXPECT_EQ(b.find_next(300001), (1 << 20) - 1);
+    EXPECT_EQ(b.find_prev((1 << 20) - 2), 300000);
+    EXPECT_EQ(b.find_prev(299999), 5);
+    EXPECT_EQ(b.find_prev(4), -1);
+
+    b.reset(300000);
+    EXPECT_EQ(b.find_next(6), (1 << 20) - 1);
+    b.reset();
+    EXPECT_TRUE(b.none());
+}
+
+TEST(BitSummaryTest, MatchesLinearSearch) {
+    BitArray plain(20000);
+    for (int i = 0; i < 20000; i += 997) plain.set(i);
+    BitArray indexed(plain);
+    indexed.build_summary();
+    indexed.set(12345).reset(997);
+    plain.set(12345).reset(997);
+
+    for (int i = 0; i < 20000; i += 101) {
+        EXPECT_EQ(indexed.find_next(i), plain.find_next(i));
+        EXPECT_EQ(indexed.find_prev(i), plain.find_prev(i));
+        EXPECT_EQ(indexed.find_next_zero(i), plain.find_next_zero(i));
+    }
+}
+
+TEST(BitSummaryTest, FreeSlotAllocation) {
+    BitArray slots(200);
+    slots.build_summary();
+    for (int i = 0; i < 200; ++i) {
+        int slot = slots.find_next_zero(0);
+        ASSERT_EQ(slot, i);
+        slots.set(slot);
+    }
+    EXPECT_EQ(slots.find_next_zero(0), -1);
+    slots.reset(130);
+    EXPECT_EQ(slots.find_next_zero(0), 130);
+}
+
+TEST(BitSummaryTest, FollowsResizeAndBulkOperations) {
+    BitArray b(100);
+    b.build_summary();
+    b.resize(5000, true);
+    EXPECT_EQ(b.find_next(0), 100);
+    EXPECT_EQ(b.find_next_zero(100), -1);
+    b.resize(50);
+    EXPECT_FALSE(b.any());
+    b.push_back(true);
+    EXPECT_EQ(b.find_next(0), 50);
+
+    BitArray mask(51);
+    b &= mask;
+    EXPECT_FALSE(b.any());
+    b = BitArray(70, 0b100);
+    EXPECT_TRUE(b.has_summary());
+    EXPECT_EQ(b.find_prev(69), 2);
+}
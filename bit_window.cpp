@@ -0,0 +1,141 @@
+#include "bit_window.hpp"
+#include "bit_stream.hpp"
+#include "bit_words.hpp"
+#include <algorithm>
+
+using bit_words::WORD_BITS;
+
+BitWindow::BitWindow(int capacity) : capacity_bits(capacity), head(0), size_bits(0), ones(0) {
+    if (capacity <= 0) throw std::invalid_argument("Ёмкость окна должна быть положительной");
+    words.assign((capacity + WORD_BITS - 1) / WORD_BITS, 0);
+}
+
+void BitWindow::push(bool bit) {
+    push_bits(bit, 1);
+}
+
+// Позиции [head, head + k) либо свободны и содержат нули, либо заняты
+// самыми старыми битами окна, поэтому вытесняемые единицы считаются одним popcount.
+void BitWindow::push_bits(uint64_t value, int k) {
+    if (k < 0 || k > WORD_BITS) throw std::invalid_argument("Можно добавить от 0 до 64 бит");
+    if (k > capacity_bits) {
+        value >>= k - capacity_bits;
+        k = capacity_bits;
+    }
+    if (k == 0) return;
+    value &= bit_words::low_mask(k);
+
+    ones -= bit_words::popcount64(load_ring(head, k));
+    ones += bit_words::popcount64(value);
+    store_ring(head, k, value);
+    head = (head + k) % capacity_bits;
+    size_bits = std::min(size_bits + k, capacity_bits);
+}
+
+void BitWindow::clear() {
+    std::fill(words.begin(), words.end(), 0);
+    head = 0;
+    size_bits = 0;
+    ones = 0;
+}
+
+int BitWindow::count() const {
+    return ones;
+}
+
+int BitWindow::count(int k) const {
+    if (k < 0 || k > size_bits) throw std::out_of_range("Выход за границу");
+    int result = 0;
+    int pos = (head - k + capacity_bits) % capacity_bits;
+    while (k > 0) {
+        int len = std::min(k, WORD_BITS);
+        result += bit_words::popcount64(load_ring(pos, len));
+        pos = (pos + len) % capacity_bits;
+        k -= len;
+    }
+    return result;
+}
+
+bool BitWindow::any() const {
+    return ones > 0;
+}
+
+bool BitWindow::any(int k) const {
+    if (k < 0 || k > size_bits) throw std::out_of_range("Выход за границу");
+    int pos = (head - k + capacity_bits) % capacity_bits;
+    while (k > 0) {
+        int len = std::min(k, WORD_BITS);
+        if (load_ring(pos, len)) return true;
+        pos = (pos + len) % capacity_bits;
+        k -= len;
+    }
+    return false;
+}
+
+bool BitWindow::none() const {
+    return ones == 0;
+}
+
+bool BitWindow::operator[](int i) const {
+    if (i < 0 || i >= size_bits) throw std::out_of_range("Выход за границу");
+    int pos = (head - size_bits + i + capacity_bits) % capacity_bits;
+    return (words[pos / WORD_BITS] >> (pos % WORD_BITS)) & 1;
+}
+
+int BitWindow::size() const {
+    return size_bits;
+}
+
+int BitWindow::capacity() const {
+    return capacity_bits;
+}
+
+bool BitWindow::full() const {
+    return size_bits == capacity_bits;
+}
+
+BitArray BitWindow::to_bit_array() const {
+    BitArray result;
+    BitWriter writer(result);
+    int pos = (head - size_bits + capacity_bits) % capacity_bits;
+    for (int left = size_bits; left > 0; left -= WORD_BITS) {
+        int len = std::min(left, WORD_BITS);
+        writer.write_bits(load_ring(pos, len), len);
+        pos = (pos + len) % capacity_bits;
+    }
+    writer.flush();
+    return result;
+}
+
+// Отрезок [pos, pos + len) без перехода через конец кольца, len <= 64.
+uint64_t BitWindow::load_segment(int pos, int len) const {
+    int w = pos / WORD_BITS;
+    int offset = pos % WORD_BITS;
+    uint64_t result = words[w] >> offset;
+    if (offset + len > WORD_BITS) result |= words[w + 1] << (WORD_BITS - offset);
+    return result & bit_words::low_mask(len);
+}
+
+void BitWindow::store_segment(int pos, int len, uint64_t value) {
+    int w = pos / WORD_BITS;
+    int offset = pos % WORD_BITS;
+    uint64_t mask = bit_words::low_mask(len);
+    words[w] = (words[w] & ~(mask << offset)) | (value << offset);
+    if (offset + len > WORD_BITS) {
+        int shift = WORD_BITS - offset;
+        words[w + 1] = (words[w + 1] & ~(mask >> shift)) | (value >> shift);
+    }
+}
+
+uint64_t BitWindow::load_ring(int pos, int len) const {
+    int first = std::min(len, capacity_bits - pos);
+    uint64_t result = load_segment(pos, first);
+    if (first < len) result |= load_segment(0, len - first) << first;
+    return result;
+}
+
+void BitWindow::store_ring(int pos, int len, uint64_t value) {
+    int first = std::min(len, capacity_bits - pos);
+    store_segment(pos, first, value & bit_words::low_mask(first));
+    if (first < len) store_segment(0, len - first, value >> first);
+}
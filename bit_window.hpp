@@ -0,0 +1,47 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include "bit_arr.hpp"
+
+// Кольцевой битовый массив фиксированной ёмкости: хранит последние capacity
+// добавленных бит и поддерживает их количество единиц за O(1) на каждое добавление.
+// Индекс 0 соответствует самому старому биту в окне.
+class BitWindow {
+public:
+    explicit BitWindow(int capacity);
+
+    //Добавляет бит, вытесняя самый старый, если окно заполнено.
+    void push(bool bit);
+    //Добавляет k младших бит value начиная с младшего, 0 <= k <= 64.
+    void push_bits(uint64_t value, int k);
+    void clear();
+
+    //Количество единиц во всём окне.
+    int count() const;
+    //Количество единиц среди последних k бит.
+    int count(int k) const;
+    bool any() const;
+    bool any(int k) const;
+    bool none() const;
+
+    bool operator[](int i) const;
+    int size() const;
+    int capacity() const;
+    bool full() const;
+
+    //Копия окна от самого старого бита к самому новому.
+    BitArray to_bit_array() const;
+
+private:
+    std::vector<uint64_t> words;
+    int capacity_bits;
+    int head;
+    int size_bits;
+    int ones;
+
+    uint64_t load_segment(int pos, int len) const;
+    void store_segment(int pos, int len, uint64_t value);
+    uint64_t load_ring(int pos, int len) const;
+    void store_ring(int pos, int len, uint64_t value);
+};
@@ -0,0 +1,75 @@
+#include "bit_window.hpp"
+#include <gtest/gtest.h>
+#include <deque>
+
+
+TEST(BitWindowTest, PushAndEvict) {
+    BitWindow w(3);
+    w.push(true);
+    w.push(false);
+    EXPECT_EQ(w.size(), 2);
+    EXPECT_FALSE(w.full());
+    EXPECT_EQ(w.count(), 1);
+
+    w.push(true);
+    w.push(true);
+    EXPECT_TRUE(w.full());
+    EXPECT_EQ(w.to_bit_array().to_string(), "011");
+    EXPECT_EQ(w.count(), 2);
+    EXPECT_TRUE(w[2]);
+    EXPECT_FALSE(w[0]);
+}
+
+TEST(BitWindowTest, MatchesReferenceModel) {
+    BitWindow w(100);
+    std::deque<bool> model;
+    uint64_t x = 12345;
+    for (int step = 0; step < 400; ++step) {
+        x = x * 6364136223846793005ull + 1442695040888963407ull;
+        int k = static_cast<int>(x >> 58);
+        uint64_t bits = x >> 7;
+        if (step % 3 == 0) {
+            w.push(bits & 1);
+            k = 1;
+        } else {
+            w.push_bits(bits, k);
+        }
+        for (int i = 0; i < k; ++i) {
+            model.push_back((bits >> i) & 1);
+            if (static_cast<int>(model.size()) > 100) model.pop_front();
+        }
+
+        ASSERT_EQ(w.size(), static_cast<int>(model.size()));
+        int total = 0;
+        for (bool b : model) total += b;
+        ASSERT_EQ(w.count(), total);
+
+        int recent = std::min(37, w.size());
+        int expected = 0;
+        for (int i = 0; i < recent; ++i) expected += model[model.size() - 1 - i];
+        ASSERT_EQ(w.count(recent), expected);
+        ASSERT_EQ(w.any(recent), expected > 0);
+    }
+    for (int i = 0; i < w.size(); ++i) EXPECT_EQ(w[i], model[i]);
+}
+
+TEST(BitWindowTest, BulkPushLongerThanCapacity) {
+    BitWindow w(10);
+    w.push_bits(0xFFFFFFFFFFFFF000ull, 64);
+    EXPECT_EQ(w.count(), 10);
+    w.push_bits(0, 5);
+    EXPECT_EQ(w.count(5), 0);
+    EXPECT_EQ(w.count(), 5);
+    w.clear();
+    EXPECT_TRUE(w.none());
+    EXPECT_EQ(w.size(), 0);
+}
+
+TEST(BitWindowTest, Errors) {
+    EXPECT_THROW(BitWindow(0), std::invalid_argument);
+    BitWindow w(8);
+    w.push(true);
+    EXPECT_THROW(w.count(2), std::out_of_range);
+    EXPECT_THROW(w[1], std::out_of_range);
+    EXPECT_THROW(w.push_bits(0, 65), std::invalid_argument);
+}
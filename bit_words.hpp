@@ -0,0 +1,127 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+
+// Чтение и запись 64-битных слов поверх байтового хранилища BitArray.
+// Бит i лежит в байте i / 8 на позиции i % 8, поэтому слово собирается
+// в порядке little-endian независимо от платформы.
+namespace bit_words
+{
+    const int WORD_BITS = 64;
+    const int WORD_BYTES = 8;
+
+    inline uint64_t load_u64(const char* p)
+    {
+        uint64_t w;
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+        std::memcpy(&w, p, WORD_BYTES);
+#else
+        w = 0;
+        for (int b = 0; b < WORD_BYTES; ++b) {
+            w |= static_cast<uint64_t>(static_cast<unsigned char>(p[b])) << (8 * b);
+        }
+#endif
+        return w;
+    }
+
+    inline void store_u64(char* p, uint64_t w)
+    {
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+        std::memcpy(p, &w, WORD_BYTES);
+#else
+        for (int b = 0; b < WORD_BYTES; ++b) {
+            p[b] = static_cast<char>(w >> (8 * b));
+        }
+#endif
+    }
+
+    // Загружает слово, начинающееся с байта byte_index; байты за nbytes считаются нулевыми.
+    inline uint64_t load_tail(const char* p, int nbytes, int byte_index)
+    {
+        if (byte_index + WORD_BYTES <= nbytes) return load_u64(p + byte_index);
+        uint64_t w = 0;
+        for (int b = 0; byte_index + b < nbytes; ++b) {
+            w |= static_cast<uint64_t>(static_cast<unsigned char>(p[byte_index + b])) << (8 * b);
+        }
+        return w;
+    }
+
+    // Записывает слово начиная с байта byte_index, не выходя за nbytes.
+    inline void store_tail(char* p, int nbytes, int byte_index, uint64_t w)
+    {
+        if (byte_index + WORD_BYTES <= nbytes) {
+            store_u64(p + byte_index, w);
+            return;
+        }
+        for (int b = 0; byte_index + b < nbytes; ++b) {
+            p[byte_index + b] = static_cast<char>(w >> (8 * b));
+        }
+    }
+
+    // 64 бита, начинающиеся с бита bit_pos, с любым выравниванием.
+    inline uint64_t load_at_bit(const char* p, int nbytes, int bit_pos)
+    {
+        int byte_index = bit_pos / 8;
+        int offset = bit_pos % 8;
+        uint64_t w = load_tail(p, nbytes, byte_index) >> offset;
+        if (offset) w |= load_tail(p, nbytes, byte_index + WORD_BYTES) << (WORD_BITS - offset);
+        return w;
+    }
+
+    // Записывает len <= 64 младших бит value начиная с бита bit_pos, не трогая соседние биты.
+    inline void store_at_bit(char* p, int nbytes, int bit_pos, uint64_t value, int len)
+    {
+        int byte_index = bit_pos / 8;
+        int offset = bit_pos % 8;
+        uint64_t value_mask = len >= WORD_BITS ? ~uint64_t(0) : ((uint64_t(1) << len) - 1);
+        value &= value_mask;
+        if (offset + len <= WORD_BITS && byte_index + WORD_BYTES <= nbytes) {
+            uint64_t w = load_u64(p + byte_index);
+            w = (w & ~(value_mask << offset)) | (value << offset);
+            store_u64(p + byte_index, w);
+            return;
+        }
+        for (int done = 0; done < len; ) {
+            int in_byte = 8 - offset < len - done ? 8 - offset : len - done;
+            unsigned char mask = static_cast<unsigned char>(((1u << in_byte) - 1) << offset);
+            unsigned char bits = static_cast<unsigned char>(((value >> done) << offset) & mask);
+            p[byte_index] = static_cast<char>((static_cast<unsigned char>(p[byte_index]) & ~mask) | bits);
+            done += in_byte;
+            ++byte_index;
+            offset = 0;
+        }
+    }
+
+    // Маска из k младших единиц, 0 <= k <= 64.
+    inline uint64_t low_mask(int k)
+    {
+        return k >= WORD_BITS ? ~uint64_t(0) : ((uint64_t(1) << k) - 1);
+    }
+
+    inline int ctz64(uint64_t w)
+    {
+        return w ? __builtin_ctzll(w) : WORD_BITS;
+    }
+
+    inline int popcount64(uint64_t w)
+    {
+        return __builtin_popcountll(w);
+    }
+
+    // Номер старшего единичного бита, w != 0.
+    inline int floor_log2(uint64_t w)
+    {
+        return WORD_BITS - 1 - __builtin_clzll(w);
+    }
+
+    inline void prefetch_read(const char* p)
+    {
+        __builtin_prefetch(p, 0);
+    }
+
+    inline void prefetch_write(char* p)
+    {
+        __builtin_prefetch(p, 1);
+    }
+}
@@ -0,0 +1,405 @@
+#include "bitops.hpp"
+#include "bit_array_view.hpp"
+#include <climits>
+#include <algorithm>
+#include <memory>
+#include <stdexcept>
+
+namespace
+{
+    // Читает упакованные байты из двоичного или текстового файла.
+    class BitSource {
+    public:
+        BitSource(FILE* f, bool text, size_t chunk_bytes)
+            : f(f), text(text), at_end(false), total_bits(0), partial(0), partial_bits(0) {
+            if (text) chars.resize(chunk_bytes);
+        }
+
+        //Возвращает ровно max_bytes байт, если поток не закончился раньше.
+        size_t read(unsigned char* dst, size_t max_bytes) {
+            if (!text) {
+                size_t n = fread(dst, 1, max_bytes, f);
+                if (ferror(f)) throw std::runtime_error("Ошибка чтения");
+                if (n < max_bytes) at_end = true;
+                total_bits += uint64_t(n) * 8;
+                return n;
+            }
+
+            size_t produced = 0;
+            while (produced < max_bytes) {
+                if (char_pos == char_count) {
+                    char_count = fread(chars.data(), 1, chars.size(), f);
+                    char_pos = 0;
+                    if (ferror(f)) throw std::runtime_error("Ошибка чтения");
+                    if (char_count == 0) {
+                        at_end = true;
+                        if (partial_bits > 0) {
+                            dst[produced++] = partial;
+                            partial = 0;
+                            partial_bits = 0;
+                        }
+                        break;
+                    }
+                }
+                char c = chars[char_pos++];
+                if (c == ' ' || c == '\n' || c == '\r' || c == '\t') continue;
+                if (c != '0' && c != '1') throw std::runtime_error("В текстовом файле допустимы только 0 и 1");
+                partial |= static_cast<unsigned char>((c - '0') << partial_bits);
+                ++total_bits;
+                if (++partial_bits == 8) {
+                    dst[produced++] = partial;
+                    partial = 0;
+                    partial_bits = 0;
+                }
+            }
+            return produced;
+        }
+
+        bool eof() const { return at_end; }
+        uint64_t bits() const { return total_bits; }
+
+    private:
+        FILE* f;
+        bool text;
+        bool at_end;
+        uint64_t total_bits;
+        std::vector<char> chars;
+        size_t char_pos = 0;
+        size_t char_count = 0;
+        unsigned char partial;
+        int partial_bits;
+    };
+
+    // Шаг конвейера над потоком байт. Суммарно на выходе столько же байт, сколько на входе,
+    // но сдвиг влево отдаёт их с задержкой и дописывает остаток в flush().
+    class Stage {
+    public:
+        virtual ~Stage() {}
+        virtual void push(std::vector<unsigned char>& data) = 0;
+        //Дописывает в data не больше limit байт; true, если осталось ещё.
+        virtual bool flush(std::vector<unsigned char>&, size_t) { return false; }
+        //Вызывается, когда известна точная длина потока.
+        virtual void finish(uint64_t) {}
+    };
+
+    class BinaryStage : public Stage {
+    public:
+        BinaryStage(BitOpKind kind, FILE* operand, bool text, size_t chunk_bytes)
+            : kind(kind), source(operand, text, chunk_bytes) {}
+
+        void push(std::vector<unsigned char>& data) override {
+            if (data.empty()) return;
+            buffer.resize(data.size());
+            if (source.read(buffer.data(), data.size()) != data.size()) {
+                throw std::runtime_error("Массивы должны иметь одинаковый размер");
+            }
+            int bits = static_cast<int>(data.size() * 8);
+            MutableBitArrayView dst(data.data(), 0, bits);
+            BitArrayView src(buffer.data(), 0, bits);
+            if (kind == BitOpKind::And) {
+                dst &= src;
+            } else if (kind == BitOpKind::Or) {
+                dst |= src;
+            } else {
+                dst ^= src;
+            }
+        }
+
+        void finish(uint64_t total_bits) override {
+            unsigned char extra;
+            if (source.read(&extra, 1) != 0 || source.bits() != total_bits) {
+                throw std::runtime_error("Массивы должны иметь одинаковый размер");
+            }
+        }
+
+    private:
+        BitOpKind kind;
+        BitSource source;
+        std::vector<unsigned char> buffer;
+    };
+
+    class NotStage : public Stage {
+    public:
+        void push(std::vector<unsigned char>& data) override {
+            MutableBitArrayView(data.data(), 0, static_cast<int>(data.size() * 8)).flip();
+        }
+    };
+
+    // Бит i результата берётся из бита i + n: первые n бит пропускаются, в конец дописываются нули.
+    class ShiftLeftStage : public Stage {
+    public:
+        explicit ShiftLeftStage(uint64_t n) : skip(n / 8), r(static_cast<int>(n % 8)) {}
+
+        void push(std::vector<unsigned char>& data) override {
+            in_count += data.size();
+            size_t i = static_cast<size_t>(std::min<uint64_t>(skip, data.size()));
+            skip -= i;
+            if (r == 0) {
+                data.erase(data.begin(), data.begin() + i);
+                out_count += data.size();
+                return;
+            }
+
+            size_t out = 0;
+            if (i < data.size() && !have_prev) {
+                prev = data[i++];
+                have_prev = true;
+            }
+            for (; i < data.size(); ++i) {
+                unsigned char x = data[i];
+                data[out++] = static_cast<unsigned char>((prev >> r) | (x << (8 - r)));
+                prev = x;
+            }
+            data.resize(out);
+            out_count += out;
+        }
+
+        bool flush(std::vector<unsigned char>& data, size_t limit) override {
+            if (have_prev && data.size() < limit) {
+                data.push_back(static_cast<unsigned char>(prev >> r));
+                have_prev = false;
+                ++out_count;
+            }
+            size_t zeros = static_cast<size_t>(std::min<uint64_t>(in_count - out_count, limit - data.size()));
+            data.insert(data.end(), zeros, 0);
+            out_count += zeros;
+            return out_count < in_count;
+        }
+
+    private:
+        uint64_t skip;
+        int r;
+        bool have_prev = false;
+        unsigned char prev = 0;
+        uint64_t in_count = 0;
+        uint64_t out_count = 0;
+    };
+
+    // Бит i результата берётся из бита i - n: в начало идут n нулевых бит, хвост отбрасывается.
+    // Задержка на n / 8 байт хранится в кольцевом буфере, который заполняется по мере чтения.
+    void seek_to(FILE* f, uint64_t pos)
+    {
+#ifdef _WIN32
+        int rc = _fseeki64(f, static_cast<__int64>(pos), SEEK_SET);
+#else
+        int rc = fseeko(f, static_cast<off_t>(pos), SEEK_SET);
+#endif
+        if (rc != 0) throw std::runtime_error("Ошибка временного файла");
+    }
+
+    // Линия задержки на n байт: байты выходят в том же порядке, но на n позже.
+    // Если n больше порции, кольцо хранится во временном файле, и в памяти
+    // остаётся только буфер на одну порцию.
+    class DelayLine {
+    public:
+        DelayLine(uint64_t n, size_t chunk_bytes) : length(n), filled(0), ring_pos(0), spill(nullptr) {
+            if (n > chunk_bytes) {
+                spill = tmpfile();
+                if (!spill) throw std::runtime_error("Ошибка временного файла");
+            }
+        }
+
+        ~DelayLine() {
+            if (spill) fclose(spill);
+        }
+
+        DelayLine(const DelayLine&) = delete;
+        DelayLine& operator=(const DelayLine&) = delete;
+
+        //Заменяет data на байты, вошедшие в линию n байт назад; вначале это нули.
+        void pass(std::vector<unsigned char>& data) {
+            size_t i = 0;
+            if (filled < length) {
+                size_t len = static_cast<size_t>(std::min<uint64_t>(length - filled, data.size()));
+                if (spill) {
+                    if (fwrite(data.data(), 1, len, spill) != len) throw std::runtime_error("Ошибка временного файла");
+                } else {
+                    ring.insert(ring.end(), data.begin(), data.begin() + len);
+                }
+                std::fill(data.begin(), data.begin() + len, 0);
+                filled += len;
+                i = len;
+            }
+            if (spill) {
+                pass_spilled(data, i);
+            } else {
+                pass_in_memory(data, i);
+            }
+        }
+
+    private:
+        uint64_t length;
+        uint64_t filled;
+        uint64_t ring_pos;
+        FILE* spill;
+        std::vector<unsigned char> ring;
+        std::vector<unsigned char> buffer;
+
+        void pass_in_memory(std::vector<unsigned char>& data, size_t i) {
+            if (!ring.empty() && data.size() - i >= ring.size()) {
+                // Короткая задержка: сдвигаем весь остаток порции разом вместо побайтового кольца.
+                std::rotate(ring.begin(), ring.begin() + static_cast<size_t>(ring_pos), ring.end());
+                ring_pos = 0;
+                buffer.assign(data.end() - ring.size(), data.end());
+                std::copy_backward(data.begin() + i, data.end() - ring.size(), data.end());
+                std::copy(ring.begin(), ring.end(), data.begin() + i);
+                ring.swap(buffer);
+                i = data.size();
+            }
+            while (i < data.size() && !ring.empty()) {
+                size_t len = std::min(data.size() - i, ring.size() - static_cast<size_t>(ring_pos));
+                std::swap_ranges(data.begin() + i, data.begin() + i + len, ring.begin() + static_cast<size_t>(ring_pos));
+                i += len;
+                ring_pos = (ring_pos + len) % ring.size();
+            }
+        }
+
+        // То же кольцо в файле: кусок читается с позиции ring_pos, и на его место пишутся новые байты.
+        void pass_spilled(std::vector<unsigned char>& data, size_t i) {
+            while (i < data.size()) {
+                size_t len = static_cast<size_t>(std::min<uint64_t>(data.size() - i, length - ring_pos));
+                buffer.resize(len);
+                seek_to(spill, ring_pos);
+                if (fread(buffer.data(), 1, len, spill) != len) throw std::runtime_error("Ошибка временного файла");
+                seek_to(spill, ring_pos);
+                if (fwrite(data.data() + i, 1, len, spill) != len) throw std::runtime_error("Ошибка временного файла");
+                std::copy(buffer.begin(), buffer.end(), data.begin() + i);
+                i += len;
+                ring_pos = (ring_pos + len) % length;
+            }
+        }
+    };
+
+    class ShiftRightStage : public Stage {
+    public:
+        ShiftRightStage(uint64_t n, size_t chunk_bytes) : delay(n / 8, chunk_bytes), r(static_cast<int>(n % 8)) {}
+
+        void push(std::vector<unsigned char>& data) override {
+            delay.pass(data);
+
+            if (r == 0) return;
+            for (unsigned char& x : data) {
+                unsigned char cur = x;
+                x = static_cast<unsigned char>((cur << r) | (prev >> (8 - r)));
+                prev = cur;
+            }
+        }
+
+    private:
+        DelayLine delay;
+        int r;
+        unsigned char prev = 0;
+    };
+
+    // Пишет результат и считает единицы. Все байты после последнего бита уже обнулены.
+    class Sink {
+    public:
+        Sink(FILE* f, bool text) : f(f), text(text), ones(0), written(0) {}
+
+        void write(const std::vector<unsigned char>& data, int64_t total_bits) {
+            if (data.empty()) return;
+            ones += BitArrayView(data.data(), 0, static_cast<int>(data.size() * 8)).count();
+            if (f) {
+                if (!text) {
+                    if (fwrite(data.data(), 1, data.size(), f) != data.size()) throw std::runtime_error("Ошибка записи");
+                } else {
+                    chars.clear();
+                    for (size_t i = 0; i < data.size(); ++i) {
+                        int bits = 8;
+                        if (total_bits >= 0 && written + i == static_cast<uint64_t>(total_bits / 8)) {
+                            bits = static_cast<int>(total_bits % 8);
+                        }
+                        for (int b = 0; b < bits; ++b) chars.push_back('0' + ((data[i] >> b) & 1));
+                    }
+                    if (fwrite(chars.data(), 1, chars.size(), f) != chars.size()) throw std::runtime_error("Ошибка записи");
+                }
+            }
+            written += data.size();
+        }
+
+        uint64_t count() const { return ones; }
+
+    private:
+        FILE* f;
+        bool text;
+        uint64_t ones;
+        uint64_t written;
+        std::vector<char> chars;
+    };
+
+    // Обнуляет биты за концом потока в последнем байте, если он попал в data.
+    void mask_tail(std::vector<unsigned char>& data, uint64_t first_byte, int64_t total_bits)
+    {
+        if (total_bits < 0 || total_bits % 8 == 0) return;
+        uint64_t last = static_cast<uint64_t>(total_bits / 8);
+        if (last >= first_byte && last < first_byte + data.size()) {
+            data[last - first_byte] &= static_cast<unsigned char>((1u << (total_bits % 8)) - 1);
+        }
+    }
+}
+
+BitPipelineResult run_bit_pipeline(FILE* input, const std::vector<BitOp>& ops, FILE* output,
+                                   bool text, size_t chunk_bytes) {
+    if (chunk_bytes == 0 || chunk_bytes > static_cast<size_t>(INT_MAX / 8)) {
+        throw std::invalid_argument("Недопустимый размер куска");
+    }
+
+    std::vector<std::unique_ptr<Stage>> stages;
+    for (const BitOp& op : ops) {
+        switch (op.kind) {
+        case BitOpKind::And:
+        case BitOpKind::Or:
+        case BitOpKind::Xor:
+            if (!op.operand) throw std::invalid_argument("Не задан второй операнд");
+            stages.emplace_back(new BinaryStage(op.kind, op.operand, text, chunk_bytes));
+            break;
+        case BitOpKind::Not:
+            stages.emplace_back(new NotStage());
+            break;
+        case BitOpKind::ShiftLeft:
+            stages.emplace_back(new ShiftLeftStage(op.shift));
+            break;
+        case BitOpKind::ShiftRight:
+            stages.emplace_back(new ShiftRightStage(op.shift, chunk_bytes));
+            break;
+        }
+    }
+
+    BitSource source(input, text, chunk_bytes);
+    Sink sink(output, text);
+    std::vector<uint64_t> emitted(stages.size() + 1, 0);
+    int64_t total_bits = -1;
+    std::vector<unsigned char> data;
+
+    auto run_from = [&](size_t first_stage) {
+        for (size_t s = first_stage; s < stages.size(); ++s) {
+            stages[s]->push(data);
+            mask_tail(data, emitted[s + 1], total_bits);
+            emitted[s + 1] += data.size();
+        }
+        sink.write(data, total_bits);
+    };
+
+    while (!source.eof()) {
+        data.resize(chunk_bytes);
+        data.resize(source.read(data.data(), chunk_bytes));
+        if (source.eof()) total_bits = static_cast<int64_t>(source.bits());
+        emitted[0] += data.size();
+        run_from(0);
+    }
+
+    for (size_t s = 0; s < stages.size(); ++s) {
+        stages[s]->finish(static_cast<uint64_t>(total_bits));
+        bool more = true;
+        while (more) {
+            data.clear();
+            more = stages[s]->flush(data, chunk_bytes);
+            mask_tail(data, emitted[s + 1], total_bits);
+            emitted[s + 1] += data.size();
+            run_from(s + 1);
+        }
+    }
+    if (output && fflush(output) != 0) throw std::runtime_error("Ошибка записи");
+
+    return BitPipelineResult{static_cast<uint64_t>(total_bits), sink.count()};
+}
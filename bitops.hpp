@@ -0,0 +1,32 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+// Потоковая обработка битовых файлов кусками фиксированного размера.
+// Биты нумеруются как в BitArray: бит i — это бит i % 8 байта i / 8.
+// В текстовом режиме каждый бит записан символом '0' или '1', пробельные символы пропускаются.
+
+enum class BitOpKind { And, Or, Xor, Not, ShiftLeft, ShiftRight };
+
+// Шаг конвейера. Для And/Or/Xor второй операнд читается из operand и должен
+// иметь ту же длину. Сдвиги работают как BitArray::operator<<= и operator>>=.
+struct BitOp {
+    BitOpKind kind;
+    FILE* operand;
+    uint64_t shift;
+};
+
+struct BitPipelineResult {
+    uint64_t bits;
+    uint64_t ones;
+};
+
+const size_t DEFAULT_CHUNK_BYTES = size_t(1) << 20;
+
+//Пропускает input через ops и пишет результат в output (если он не nullptr).
+//Памяти нужно O(chunk_bytes) на шаг; задержку сдвига вправо длиннее порции хранит временный файл.
+BitPipelineResult run_bit_pipeline(FILE* input, const std::vector<BitOp>& ops, FILE* output,
+                                   bool text, size_t chunk_bytes = DEFAULT_CHUNK_BYTES);
@@ -0,0 +1,126 @@
+#include "bitops.hpp"
+#include "bit_arr.hpp"
+#include <gtest/gtest.h>
+#include <string>
+
+
+namespace
+{
+    BitArray make_bits(int size, uint64_t seed) {
+        BitArray result(size);
+        for (int i = 0; i < size; ++i) {
+            seed = seed * 6364136223846793005ull + 1442695040888963407ull;
+            result.set(i, (seed >> 61) & 1);
+        }
+        return result;
+    }
+
+    FILE* file_with(const BitArray& bits, bool text) {
+        FILE* f = tmpfile();
+        std::string s = bits.to_string();
+        if (text) {
+            fputs(s.c_str(), f);
+        } else {
+            for (size_t i = 0; i < s.size(); i += 8) {
+                unsigned char byte = 0;
+                for (size_t b = 0; b < 8 && i + b < s.size(); ++b) byte |= (s[i + b] - '0') << b;
+                fputc(byte, f);
+            }
+        }
+        rewind(f);
+        return f;
+    }
+
+    std::string read_back(FILE* f, int size, bool text) {
+        rewind(f);
+        std::string result;
+        int c;
+        if (text) {
+            while ((c = fgetc(f)) != EOF) result.push_back(static_cast<char>(c));
+            return result;
+        }
+        while ((c = fgetc(f)) != EOF) {
+            for (int b = 0; b < 8 && static_cast<int>(result.size()) < size; ++b) result.push_back('0' + ((c >> b) & 1));
+        }
+        return result;
+    }
+}
+
+TEST(BitopsTest, PipelineMatchesBitArray) {
+    for (bool text : {false, true}) {
+        int size = text ? 1003 : 1000;
+        BitArray a = make_bits(size, 1);
+        BitArray b = make_bits(size, 2);
+        BitArray c = make_bits(size, 3);
+
+        FILE* fa = file_with(a, text);
+        FILE* fb = file_with(b, text);
+        FILE* fc = file_with(c, text);
+        FILE* out = tmpfile();
+        std::vector<BitOp> ops = {
+            {BitOpKind::And, fb, 0},
+            {BitOpKind::ShiftLeft, nullptr, 77},
+            {BitOpKind::Not, nullptr, 0},
+            {BitOpKind::Xor, fc, 0},
+            {BitOpKind::ShiftRight, nullptr, 13},
+        };
+        BitPipelineResult r = run_bit_pipeline(fa, ops, out, text, 7);
+
+        BitArray expected = ((~((a & b) << 77)) ^ c) >> 13;
+        EXPECT_EQ(r.bits, static_cast<uint64_t>(size));
+        EXPECT_EQ(r.ones, static_cast<uint64_t>(expected.count()));
+        EXPECT_EQ(read_back(out, size, text), expected.to_string()) << text;
+        for (FILE* f : {fa, fb, fc, out}) fclose(f);
+    }
+}
+
+TEST(BitopsTest, ShiftsAcrossChunks) {
+    BitArray a = make_bits(400, 9);
+    for (uint64_t n : {0, 1, 8, 9, 63, 200, 399, 400, 5000}) {
+        for (BitOpKind kind : {BitOpKind::ShiftLeft, BitOpKind::ShiftRight}) {
+            FILE* in = file_with(a, false);
+            FILE* out = tmpfile();
+            run_bit_pipeline(in, {BitOp{kind, nullptr, n}}, out, false, 5);
+            BitArray expected = kind == BitOpKind::ShiftLeft ? a << static_cast<int>(n) : a >> static_cast<int>(n);
+            EXPECT_EQ(read_back(out, 400, false), expected.to_string()) << n;
+            fclose(in);
+            fclose(out);
+        }
+    }
+}
+
+TEST(BitopsTest, LongShiftRightSpillsToFile) {
+    // Задержка в сотни порций уходит во временный файл и несколько раз проходит по кольцу.
+    BitArray a = make_bits(40000, 3);
+    for (uint64_t n : {8003, 16000, 39999}) {
+        FILE* in = file_with(a, false);
+        FILE* out = tmpfile();
+        run_bit_pipeline(in, {BitOp{BitOpKind::ShiftRight, nullptr, n}, BitOp{BitOpKind::Not, nullptr, 0}}, out, false, 7);
+        EXPECT_EQ(read_back(out, 40000, false), (~(a >> static_cast<int>(n))).to_string()) << n;
+        fclose(in);
+        fclose(out);
+    }
+}
+
+TEST(BitopsTest, CountOnly) {
+    BitArray a = make_bits(4096, 5);
+    FILE* in = file_with(a, false);
+    BitPipelineResult r = run_bit_pipeline(in, {}, nullptr, false);
+    EXPECT_EQ(r.ones, static_cast<uint64_t>(a.count()));
+    fclose(in);
+}
+
+TEST(BitopsTest, SizeMismatch) {
+    for (bool text : {false, true}) {
+        FILE* a = file_with(make_bits(64, 1), text);
+        FILE* b = file_with(make_bits(text ? 63 : 56, 2), text);
+        EXPECT_THROW(run_bit_pipeline(a, {BitOp{BitOpKind::Or, b, 0}}, nullptr, text), std::runtime_error);
+        fclose(a);
+        fclose(b);
+    }
+    FILE* bad = tmpfile();
+    fputs("0102", bad);
+    rewind(bad);
+    EXPECT_THROW(run_bit_pipeline(bad, {}, nullptr, true), std::runtime_error);
+    fclose(bad);
+}
@@ -1,66 +1,122 @@
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
 #include <iostream>
-#include "bit_arr.hpp"
-
-int main() 
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "bitops.hpp"
+
+// bitops — потоковые битовые операции над файлами произвольного размера.
+//
+//   bitops [-t] [-b байт] [-o выход] вход [операция]...
+//
+// Операции выполняются слева направо:
+//   and ФАЙЛ, or ФАЙЛ, xor ФАЙЛ — с файлом той же длины;
+//   not;
+//   shl N, shr N — сдвиг на N бит как у BitArray::operator<<= и operator>>=;
+//   count — вывести число единиц результата (должна быть последней).
+// -t: файлы в текстовом виде из символов 0 и 1, иначе двоичные.
+// -b: размер куска в байтах (по умолчанию 1 МиБ). Файл "-" — stdin/stdout.
+
+namespace
 {
-        int size;
-        std::cout << "Введите размер битового массива: ";
-        std::cin >> size;
-
-        if (size <= 0) {
-            throw std::invalid_argument("Размер массива должен быть положительным числом");
+    void usage()
+    {
+        std::cerr << "Использование: bitops [-t] [-b байт] [-o выход] вход "
+                     "[and|or|xor ФАЙЛ | not | shl N | shr N]... [count]" << std::endl;
+    }
+
+    FILE* open_file(const std::string& name, const char* mode, std::vector<FILE*>& opened)
+    {
+        if (name == "-") return mode[0] == 'r' ? stdin : stdout;
+        FILE* f = fopen(name.c_str(), mode);
+        if (!f) throw std::runtime_error("Не удалось открыть " + name + ": " + strerror(errno));
+        opened.push_back(f);
+        return f;
+    }
+
+    uint64_t parse_count(const std::string& s)
+    {
+        char* end = nullptr;
+        errno = 0;
+        unsigned long long v = strtoull(s.c_str(), &end, 10);
+        if (s.empty() || s[0] == '-' || *end != '\0' || errno) throw std::invalid_argument("Некорректное число: " + s);
+        return v;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    std::vector<FILE*> opened;
+    try {
+        bool text = false;
+        size_t chunk_bytes = DEFAULT_CHUNK_BYTES;
+        std::string output_name;
+        int i = 1;
+        for (; i < argc && argv[i][0] == '-' && argv[i][1] != '\0'; ++i) {
+            std::string flag = argv[i];
+            if (flag == "-t") {
+                text = true;
+            } else if ((flag == "-o" || flag == "-b") && i + 1 < argc) {
+                if (flag == "-o") {
+                    output_name = argv[++i];
+                } else {
+                    chunk_bytes = static_cast<size_t>(parse_count(argv[++i]));
+                }
+            } else {
+                usage();
+                return 2;
+            }
         }
-
-        BitArray bitArray(size);
-
-        std::cout << "Введите значения битов (0 или 1):" << std::endl;
-        for (int i = 0; i < size; ++i) {
-            bool value;
-            std::cin >> value;
-            bitArray.set(i, value);
+        if (i >= argc) {
+            usage();
+            return 2;
         }
 
-        std::cout << "Битовый массив: " << bitArray.to_string() << std::endl;
-
-        // Пример операций
-        std::cout << "Пример операций:" << std::endl;
-        BitArray inverted = ~bitArray;
-        std::cout << "Инвертированный массив: " << inverted.to_string() << std::endl;
-
-        BitArray shiftedLeft = bitArray << 1;
-        std::cout << "Сдвиг влево на 1: " << shiftedLeft.to_string() << std::endl;
-
-        BitArray shiftedRight = bitArray >> 1;
-        std::cout << "Сдвиг вправо на 1: " << shiftedRight.to_string() << std::endl;
-
-        // Сравнение массивов
-        BitArray anotherArray(size);
-        std::cout << "Введите значения для второго битового массива:" << std::endl;
-        for (int i = 0; i < size; ++i) {
-            bool value;
-            std::cin >> value;
-            anotherArray.set(i, value);
+        FILE* input = open_file(argv[i++], text ? "r" : "rb", opened);
+        std::vector<BitOp> ops;
+        bool count = false;
+        for (; i < argc; ++i) {
+            std::string op = argv[i];
+            if (count) throw std::invalid_argument("count должна быть последней операцией");
+            if ((op == "and" || op == "or" || op == "xor") && i + 1 < argc) {
+                BitOpKind kind = op == "and" ? BitOpKind::And : op == "or" ? BitOpKind::Or : BitOpKind::Xor;
+                ops.push_back(BitOp{kind, open_file(argv[++i], text ? "r" : "rb", opened), 0});
+            } else if ((op == "shl" || op == "shr") && i + 1 < argc) {
+                BitOpKind kind = op == "shl" ? BitOpKind::ShiftLeft : BitOpKind::ShiftRight;
+                ops.push_back(BitOp{kind, nullptr, parse_count(argv[++i])});
+            } else if (op == "not") {
+                ops.push_back(BitOp{BitOpKind::Not, nullptr, 0});
+            } else if (op == "count") {
+                count = true;
+            } else {
+                usage();
+                return 2;
+            }
         }
 
-        std::cout << "Второй битовый массив: " << anotherArray.to_string() << std::endl;
-
-        if (bitArray == anotherArray) {
-            std::cout << "Массивы равны." << std::endl;
-        } else {
-            std::cout << "Массивы не равны." << std::endl;
+        FILE* output = nullptr;
+        if (!output_name.empty()) {
+            output = open_file(output_name, text ? "w" : "wb", opened);
+        } else if (!count) {
+            output = stdout;
         }
 
-        BitArray andResult = bitArray & anotherArray;
-        std::cout << "Результат побитового И: " << andResult.to_string() << std::endl;
-
-        BitArray orResult = bitArray | anotherArray;
-        std::cout << "Результат побитового ИЛИ: " << orResult.to_string() << std::endl;
-
-        BitArray xorResult = bitArray ^ anotherArray;
-        std::cout << "Результат побитового XOR: " << xorResult.to_string() << std::endl;
-
-        return 0;
-
-    } 
-
-    
\ No newline at end of file
+        BitPipelineResult result = run_bit_pipeline(input, ops, output, text, chunk_bytes);
+        if (text && output) fputc('\n', output);
+        if (count) std::cout << result.ones << std::endl;
+    } catch (const std::exception& e) {
+        std::cerr << "bitops: " << e.what() << std::endl;
+        for (FILE* f : opened) fclose(f);
+        return 1;
+    }
+    for (FILE* f : opened) {
+        if (fclose(f) != 0) {
+            std::cerr << "bitops: ошибка записи" << std::endl;
+            return 1;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,381 @@
+#include "persistent_bit_arr.hpp"
+#include "bit_stream.hpp"
+#include "bit_array_view.hpp"
+#include "bit_words.hpp"
+#include <algorithm>
+#include <atomic>
+
+using bit_words::WORD_BITS;
+
+// Лист хранит words, внутренний узел - ровно BRANCH детей. Узел с ненулевым edit
+// принадлежит редактору с этим номером и может меняться только им.
+struct PersistentBitArray::Node {
+    uint64_t edit = 0;
+    int ones = 0;
+    std::vector<uint64_t> words;
+    std::vector<NodePtr> children;
+};
+
+namespace
+{
+    uint64_t next_edit()
+    {
+        static std::atomic<uint64_t> counter(0);
+        return ++counter;
+    }
+
+    int depth_for(int size_bits)
+    {
+        int64_t chunks = (static_cast<int64_t>(size_bits) + PersistentBitArray::CHUNK_BITS - 1) / PersistentBitArray::CHUNK_BITS;
+        int depth = 0;
+        for (int64_t span = 1; span < chunks; span *= PersistentBitArray::BRANCH) ++depth;
+        return depth;
+    }
+
+    //Число блоков под узлом уровня level (лист - уровень 0).
+    int64_t chunks_under(int level)
+    {
+        int64_t span = 1;
+        for (int l = 0; l < level; ++l) span *= PersistentBitArray::BRANCH;
+        return span;
+    }
+}
+
+PersistentBitArray::NodePtr PersistentBitArray::zero_tree(int depth) {
+    NodePtr node = std::make_shared<Node>();
+    node->words.assign(CHUNK_WORDS, 0);
+    for (int l = 0; l < depth; ++l) {
+        NodePtr parent = std::make_shared<Node>();
+        parent->children.assign(BRANCH, node);
+        node = parent;
+    }
+    return node;
+}
+
+const uint64_t* PersistentBitArray::chunk_words(const Node* root, int depth, int chunk) {
+    const Node* node = root;
+    for (int l = depth - 1; l >= 0; --l) {
+        node = node->children[(chunk / chunks_under(l)) % BRANCH].get();
+    }
+    return node->words.data();
+}
+
+PersistentBitArray::PersistentBitArray() : PersistentBitArray(0) {}
+
+PersistentBitArray::PersistentBitArray(int size_bits)
+    : root(), size_bits(size_bits), depth(depth_for(size_bits)) {
+    if (size_bits < 0) throw std::invalid_argument("Кол-во битов не может быть отрицательным");
+    root = zero_tree(depth);
+}
+
+PersistentBitArray::PersistentBitArray(const BitArray& bits)
+    : root(), size_bits(bits.size()), depth(depth_for(bits.size())) {
+    BitArrayView view = bits.slice(0, size_bits);
+    int chunks = std::max((view.word_count() + CHUNK_WORDS - 1) / CHUNK_WORDS, 1);
+
+    // Строим листья, затем собираем уровни снизу вверх; пустые места занимает общий нулевой узел.
+    NodePtr zero = zero_tree(0);
+    std::vector<NodePtr> level;
+    for (int c = 0; c < chunks; ++c) {
+        NodePtr leaf = std::make_shared<Node>();
+        leaf->words.resize(CHUNK_WORDS);
+        for (int i = 0; i < CHUNK_WORDS; ++i) {
+            leaf->words[i] = view.word(c * CHUNK_WORDS + i);
+            leaf->ones += bit_words::popcount64(leaf->words[i]);
+        }
+        level.push_back(leaf->ones ? leaf : zero);
+    }
+    for (int l = 0; l < depth; ++l) {
+        std::vector<NodePtr> parents;
+        for (size_t i = 0; i < level.size(); i += BRANCH) {
+            NodePtr parent = std::make_shared<Node>();
+            parent->children.assign(BRANCH, zero);
+            for (size_t j = i; j < std::min(level.size(), i + BRANCH); ++j) {
+                parent->children[j - i] = level[j];
+                parent->ones += level[j]->ones;
+            }
+            parents.push_back(parent);
+        }
+        NodePtr parent_zero = std::make_shared<Node>();
+        parent_zero->children.assign(BRANCH, zero);
+        zero = parent_zero;
+        level.swap(parents);
+    }
+    root = level[0];
+}
+
+PersistentBitArray::PersistentBitArray(NodePtr root, int size_bits, int depth)
+    : root(std::move(root)), size_bits(size_bits), depth(depth) {}
+
+PersistentBitArray PersistentBitArray::set(int n, bool val) const {
+    Editor editor(*this);
+    editor.set(n, val);
+    return editor.commit();
+}
+
+PersistentBitArray PersistentBitArray::reset(int n) const {
+    return set(n, false);
+}
+
+PersistentBitArray PersistentBitArray::flip(int n) const {
+    Editor editor(*this);
+    editor.flip(n);
+    return editor.commit();
+}
+
+bool PersistentBitArray::operator[](int i) const {
+    if (i < 0 || i >= size_bits) throw std::out_of_range("Выход за границу");
+    const uint64_t* words = chunk_words(root.get(), depth, i / CHUNK_BITS);
+    return (words[(i % CHUNK_BITS) / WORD_BITS] >> (i % WORD_BITS)) & 1;
+}
+
+int PersistentBitArray::size() const {
+    return size_bits;
+}
+
+bool PersistentBitArray::empty() const {
+    return size_bits == 0;
+}
+
+bool PersistentBitArray::any() const {
+    return root->ones != 0;
+}
+
+bool PersistentBitArray::none() const {
+    return !any();
+}
+
+int PersistentBitArray::count() const {
+    return root->ones;
+}
+
+int PersistentBitArray::find_next(int from) const {
+    if (from < 0) throw std::out_of_range("Выход за границу");
+    if (from >= size_bits) return -1;
+    return static_cast<int>(next_set(root.get(), depth, 0, from));
+}
+
+int64_t PersistentBitArray::next_set(const Node* node, int level, int64_t first_chunk, int64_t from) {
+    if (!node->ones) return -1;
+    if (level == 0) {
+        int64_t base = first_chunk * CHUNK_BITS;
+        for (int i = static_cast<int>(std::max<int64_t>(from - base, 0) / WORD_BITS); i < CHUNK_WORDS; ++i) {
+            int64_t word_base = base + i * WORD_BITS;
+            uint64_t w = node->words[i];
+            if (from > word_base) w &= ~bit_words::low_mask(static_cast<int>(from - word_base));
+            if (w) return word_base + bit_words::ctz64(w);
+        }
+        return -1;
+    }
+    int64_t span = chunks_under(level - 1);
+    int64_t start = std::max<int64_t>(from / CHUNK_BITS - first_chunk, 0) / span;
+    for (int64_t i = start; i < BRANCH; ++i) {
+        int64_t found = next_set(node->children[i].get(), level - 1, first_chunk + i * span, from);
+        if (found >= 0) return found;
+    }
+    return -1;
+}
+
+std::vector<int> PersistentBitArray::changed_chunks(const PersistentBitArray& other) const {
+    if (size_bits != other.size_bits) throw std::invalid_argument("Массивы должны иметь одинаковый размер");
+    std::vector<int> result;
+    collect_changes(root.get(), other.root.get(), depth, 0, result);
+    return result;
+}
+
+void PersistentBitArray::collect_changes(const Node* a, const Node* b, int level, int64_t first_chunk, std::vector<int>& out) {
+    if (a == b) return;
+    if (level == 0) {
+        if (a->words != b->words) out.push_back(static_cast<int>(first_chunk));
+        return;
+    }
+    int64_t span = chunks_under(level - 1);
+    for (int i = 0; i < BRANCH; ++i) {
+        collect_changes(a->children[i].get(), b->children[i].get(), level - 1, first_chunk + i * span, out);
+    }
+}
+
+BitArray PersistentBitArray::to_bit_array() const {
+    BitArray result;
+    BitWriter writer(result);
+    const uint64_t* chunk = nullptr;
+    for (int pos = 0; pos < size_bits; pos += WORD_BITS) {
+        if (pos % CHUNK_BITS == 0) chunk = chunk_words(root.get(), depth, pos / CHUNK_BITS);
+        writer.write_bits(chunk[(pos % CHUNK_BITS) / WORD_BITS], std::min(size_bits - pos, WORD_BITS));
+    }
+    writer.flush();
+    return result;
+}
+
+std::string PersistentBitArray::to_string() const {
+    return to_bit_array().to_string();
+}
+
+bool operator==(const PersistentBitArray& a, const PersistentBitArray& b) {
+    return a.size_bits == b.size_bits && a.changed_chunks(b).empty();
+}
+
+bool operator!=(const PersistentBitArray& a, const PersistentBitArray& b) {
+    return !(a == b);
+}
+
+PersistentBitArray::Editor::Editor(const PersistentBitArray& base)
+    : root(base.root), size_bits(base.size_bits), depth(base.depth), edit(next_edit()) {}
+
+PersistentBitArray::Node* PersistentBitArray::Editor::writable(NodePtr& node) {
+    if (node->edit != edit) {
+        node = std::make_shared<Node>(*node);
+        node->edit = edit;
+    }
+    return node.get();
+}
+
+PersistentBitArray::Editor& PersistentBitArray::Editor::set(int n, bool val) {
+    if ((*this)[n] == val) return *this;
+
+    int delta = val ? 1 : -1;
+    int chunk = n / CHUNK_BITS;
+    Node* node = writable(root);
+    node->ones += delta;
+    for (int l = depth - 1; l >= 0; --l) {
+        node = writable(node->children[(chunk / chunks_under(l)) % BRANCH]);
+        node->ones += delta;
+    }
+    node->words[(n % CHUNK_BITS) / WORD_BITS] ^= uint64_t(1) << (n % WORD_BITS);
+    return *this;
+}
+
+PersistentBitArray::Editor& PersistentBitArray::Editor::reset(int n) {
+    return set(n, false);
+}
+
+PersistentBitArray::Editor& PersistentBitArray::Editor::flip(int n) {
+    return set(n, !(*this)[n]);
+}
+
+bool PersistentBitArray::Editor::operator[](int i) const {
+    if (i < 0 || i >= size_bits) throw std::out_of_range("Выход за границу");
+    const uint64_t* words = chunk_words(root.get(), depth, i / CHUNK_BITS);
+    return (words[(i % CHUNK_BITS) / WORD_BITS] >> (i % WORD_BITS)) & 1;
+}
+
+int PersistentBitArray::Editor::size() const {
+    return size_bits;
+}
+
+PersistentBitArray PersistentBitArray::Editor::commit() {
+    PersistentBitArray result(root, size_bits, depth);
+    edit = next_edit();
+    return result;
+}
+
+// Запись читателя: pointer - версия, которую он держит. Записи не удаляются до
+// разрушения ячейки и переиспользуются следующими читателями через флаг active.
+struct BitArraySnapshots::Hazard {
+    std::atomic<const PersistentBitArray*> pointer{nullptr};
+    std::atomic<bool> active{false};
+    Hazard* next = nullptr;
+};
+
+BitArraySnapshots::BitArraySnapshots(PersistentBitArray initial)
+    : current(new PersistentBitArray(std::move(initial))), hazards(nullptr) {}
+
+BitArraySnapshots::~BitArraySnapshots() {
+    delete current.load();
+    for (const PersistentBitArray* version : retired) delete version;
+    Hazard* h = hazards.load();
+    while (h) {
+        Hazard* next = h->next;
+        delete h;
+        h = next;
+    }
+}
+
+BitArraySnapshots::Snapshot BitArraySnapshots::load() const {
+    Hazard* hazard = acquire_hazard();
+    // Отмечаем версию и перечитываем указатель: если он не изменился, писатель
+    // уже увидит отметку и не удалит версию.
+    const PersistentBitArray* version = current.load();
+    while (true) {
+        hazard->pointer.store(version);
+        const PersistentBitArray* again = current.load();
+        if (again == version) break;
+        version = again;
+    }
+    return Snapshot(version, hazard);
+}
+
+void BitArraySnapshots::publish(PersistentBitArray version) {
+    const PersistentBitArray* fresh = new PersistentBitArray(std::move(version));
+    retired.push_back(current.exchange(fresh));
+    reclaim();
+}
+
+BitArraySnapshots::Hazard* BitArraySnapshots::acquire_hazard() const {
+    for (Hazard* h = hazards.load(); h; h = h->next) {
+        bool expected = false;
+        if (!h->active.load() && h->active.compare_exchange_strong(expected, true)) return h;
+    }
+    Hazard* h = new Hazard;
+    h->active.store(true);
+    h->next = hazards.load();
+    while (!hazards.compare_exchange_weak(h->next, h)) {}
+    return h;
+}
+
+void BitArraySnapshots::reclaim() {
+    std::vector<const PersistentBitArray*> held;
+    for (Hazard* h = hazards.load(); h; h = h->next) {
+        const PersistentBitArray* p = h->pointer.load();
+        if (p) held.push_back(p);
+    }
+    std::sort(held.begin(), held.end());
+
+    size_t kept = 0;
+    for (const PersistentBitArray* version : retired) {
+        if (std::binary_search(held.begin(), held.end(), version)) {
+            retired[kept++] = version;
+        } else {
+            delete version;
+        }
+    }
+    retired.resize(kept);
+}
+
+BitArraySnapshots::Snapshot::Snapshot(const PersistentBitArray* version, Hazard* hazard)
+    : version(version), hazard(hazard) {}
+
+BitArraySnapshots::Snapshot::Snapshot(Snapshot&& other) noexcept
+    : version(other.version), hazard(other.hazard) {
+    other.version = nullptr;
+    other.hazard = nullptr;
+}
+
+BitArraySnapshots::Snapshot& BitArraySnapshots::Snapshot::operator=(Snapshot&& other) noexcept {
+    if (this != &other) {
+        release();
+        std::swap(version, other.version);
+        std::swap(hazard, other.hazard);
+    }
+    return *this;
+}
+
+BitArraySnapshots::Snapshot::~Snapshot() {
+    release();
+}
+
+const PersistentBitArray& BitArraySnapshots::Snapshot::operator*() const {
+    return *version;
+}
+
+const PersistentBitArray* BitArraySnapshots::Snapshot::operator->() const {
+    return version;
+}
+
+void BitArraySnapshots::Snapshot::release() {
+    if (!hazard) return;
+    hazard->pointer.store(nullptr);
+    hazard->active.store(false);
+    hazard = nullptr;
+    version = nullptr;
+}
@@ -0,0 +1,143 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include "bit_arr.hpp"
+
+// Неизменяемый битовый массив фиксированного размера. Биты лежат в дереве блоков
+// по CHUNK_WORDS слов с ветвлением BRANCH; версии делят все неизменённые блоки,
+// поэтому новая версия стоит O(изменённых блоков), а не копии всего буфера.
+// Читать одну версию можно из любого числа потоков без синхронизации.
+class PersistentBitArray {
+public:
+    static const int CHUNK_WORDS = 8;
+    static const int CHUNK_BITS = CHUNK_WORDS * 64;
+    static const int BRANCH = 32;
+
+    class Editor;
+
+    PersistentBitArray();
+    explicit PersistentBitArray(int size_bits);
+    explicit PersistentBitArray(const BitArray& bits);
+
+    //Новые версии; текущая не меняется.
+    PersistentBitArray set(int n, bool val = true) const;
+    PersistentBitArray reset(int n) const;
+    PersistentBitArray flip(int n) const;
+
+    bool operator[](int i) const;
+    int size() const;
+    bool empty() const;
+
+    bool any() const;
+    bool none() const;
+    int count() const;
+    int find_next(int from) const;
+
+    //Номера блоков, в которых версии различаются; общие поддеревья не просматриваются.
+    std::vector<int> changed_chunks(const PersistentBitArray& other) const;
+
+    BitArray to_bit_array() const;
+    std::string to_string() const;
+
+private:
+    struct Node;
+    using NodePtr = std::shared_ptr<Node>;
+
+    NodePtr root;
+    int size_bits;
+    int depth;
+
+    PersistentBitArray(NodePtr root, int size_bits, int depth);
+
+    static NodePtr zero_tree(int depth);
+    static const uint64_t* chunk_words(const Node* root, int depth, int chunk);
+    static int64_t next_set(const Node* node, int level, int64_t first_chunk, int64_t from);
+    static void collect_changes(const Node* a, const Node* b, int level, int64_t first_chunk, std::vector<int>& out);
+
+    friend bool operator==(const PersistentBitArray& a, const PersistentBitArray& b);
+};
+
+// Накопитель изменений для одного писателя. Блок копируется при первом изменении
+// и дальше правится на месте; commit() отдаёт готовую версию, после чего все её
+// блоки снова считаются неизменяемыми.
+class PersistentBitArray::Editor {
+public:
+    explicit Editor(const PersistentBitArray& base);
+
+    Editor& set(int n, bool val = true);
+    Editor& reset(int n);
+    Editor& flip(int n);
+
+    bool operator[](int i) const;
+    int size() const;
+
+    PersistentBitArray commit();
+
+private:
+    NodePtr root;
+    int size_bits;
+    int depth;
+    uint64_t edit;
+
+    Node* writable(NodePtr& node);
+};
+
+bool operator==(const PersistentBitArray& a, const PersistentBitArray& b);
+bool operator!=(const PersistentBitArray& a, const PersistentBitArray& b);
+
+// Ячейка с текущей версией для одного писателя и любого числа читателей.
+// Текущая версия лежит в атомарном указателе; load() читает его и отмечает версию
+// в своей hazard-записи, без мьютексов и ожидания писателя. publish() подменяет
+// указатель, а старые версии удаляет сам писатель, когда ни одна запись на них
+// не указывает. publish() должен вызывать один поток.
+class BitArraySnapshots {
+public:
+    class Snapshot;
+
+    explicit BitArraySnapshots(PersistentBitArray initial = PersistentBitArray());
+    ~BitArraySnapshots();
+
+    BitArraySnapshots(const BitArraySnapshots&) = delete;
+    BitArraySnapshots& operator=(const BitArraySnapshots&) = delete;
+
+    //Версия остаётся доступной, пока жив возвращённый Snapshot.
+    Snapshot load() const;
+    void publish(PersistentBitArray version);
+
+private:
+    struct Hazard;
+
+    std::atomic<const PersistentBitArray*> current;
+    mutable std::atomic<Hazard*> hazards;
+    std::vector<const PersistentBitArray*> retired;
+
+    Hazard* acquire_hazard() const;
+    void reclaim();
+};
+
+// Удерживает версию, полученную из BitArraySnapshots::load(); ячейка должна жить дольше.
+class BitArraySnapshots::Snapshot {
+public:
+    Snapshot(Snapshot&& other) noexcept;
+    Snapshot& operator=(Snapshot&& other) noexcept;
+    ~Snapshot();
+
+    Snapshot(const Snapshot&) = delete;
+    Snapshot& operator=(const Snapshot&) = delete;
+
+    const PersistentBitArray& operator*() const;
+    const PersistentBitArray* operator->() const;
+
+private:
+    const PersistentBitArray* version;
+    Hazard* hazard;
+
+    Snapshot(const PersistentBitArray* version, Hazard* hazard);
+    void release();
+
+    friend class BitArraySnapshots;
+};
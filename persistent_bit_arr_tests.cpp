@@ -0,0 +1,110 @@
+#include "persistent_bit_arr.hpp"
+#include <gtest/gtest.h>
+#include <atomic>
+#include <climits>
+#include <thread>
+
+
+TEST(PersistentBitArrayTest, VersionsAreIndependent) {
+    PersistentBitArray v0(100000);
+    PersistentBitArray v1 = v0.set(5).set(70000);
+    PersistentBitArray v2 = v1.reset(5).flip(99999);
+
+    EXPECT_TRUE(v0.none());
+    EXPECT_EQ(v1.count(), 2);
+    EXPECT_TRUE(v1[5]);
+    EXPECT_TRUE(v1[70000]);
+    EXPECT_FALSE(v2[5]);
+    EXPECT_TRUE(v2[99999]);
+    EXPECT_EQ(v2.count(), 2);
+    EXPECT_THROW(v2[100000], std::out_of_range);
+}
+
+TEST(PersistentBitArrayTest, MatchesBitArray) {
+    BitArray plain(50000);
+    for (int i = 0; i < 50000; i += 37) plain.set(i);
+    PersistentBitArray bits(plain);
+    EXPECT_EQ(bits.to_string(), plain.to_string());
+    EXPECT_EQ(bits.count(), plain.count());
+
+    PersistentBitArray::Editor editor(bits);
+    for (int i = 0; i < 50000; i += 1001) {
+        editor.flip(i);
+        plain.set(i, !plain[i]);
+    }
+    PersistentBitArray next = editor.commit();
+    EXPECT_EQ(next.to_bit_array(), plain);
+    EXPECT_EQ(next.count(), plain.count());
+    for (int i = 0; i < 50000; i += 97) {
+        EXPECT_EQ(next.find_next(i), plain.find_next(i)) << i;
+    }
+}
+
+TEST(PersistentBitArrayTest, ChangedChunksOnly) {
+    PersistentBitArray base(1 << 20);
+    PersistentBitArray::Editor editor(base);
+    editor.set(3).set(10).set(600000);
+    PersistentBitArray first = editor.commit();
+    editor.set(PersistentBitArray::CHUNK_BITS * 7);
+    PersistentBitArray second = editor.commit();
+
+    std::vector<int> expected = {0, 600000 / PersistentBitArray::CHUNK_BITS};
+    EXPECT_EQ(base.changed_chunks(first), expected);
+    EXPECT_EQ(first.changed_chunks(second), std::vector<int>{7});
+    EXPECT_FALSE(first[PersistentBitArray::CHUNK_BITS * 7]);
+    EXPECT_TRUE(first == first.set(3));
+    EXPECT_TRUE(first != second);
+}
+
+TEST(PersistentBitArrayTest, FindNextSkipsEmptySubtrees) {
+    PersistentBitArray bits = PersistentBitArray(3000000).set(2999999).set(12);
+    EXPECT_EQ(bits.find_next(0), 12);
+    EXPECT_EQ(bits.find_next(13), 2999999);
+    EXPECT_EQ(bits.reset(2999999).find_next(13), -1);
+    EXPECT_EQ(PersistentBitArray().find_next(0), -1);
+
+    PersistentBitArray huge = PersistentBitArray(INT_MAX).set(INT_MAX - 1);
+    EXPECT_EQ(huge.find_next(0), INT_MAX - 1);
+    EXPECT_EQ(huge.count(), 1);
+}
+
+TEST(PersistentBitArrayTest, ReadersSeeConsistentVersions) {
+    // Писатель каждый раз ставит два бита, так что в любой опубликованной версии их чётное число.
+    BitArraySnapshots snapshots(PersistentBitArray(1 << 16));
+    std::atomic<bool> done(false);
+    std::atomic<int> bad(0);
+
+    std::vector<std::thread> readers;
+    for (int t = 0; t < 3; ++t) {
+        readers.emplace_back([&] {
+            while (!done) {
+                BitArraySnapshots::Snapshot version = snapshots.load();
+                if (version->count() % 2 != 0 || version->count() != version->to_bit_array().count()) ++bad;
+            }
+        });
+    }
+
+    PersistentBitArray::Editor editor(*snapshots.load());
+    for (int i = 0; i < 2000; ++i) {
+        editor.set((i * 7919) % (1 << 16)).set((i * 7919 + 1) % (1 << 16));
+        snapshots.publish(editor.commit());
+    }
+    done = true;
+    for (std::thread& reader : readers) reader.join();
+
+    EXPECT_EQ(bad, 0);
+    EXPECT_EQ(snapshots.load()->count(), 4000);
+}
+
+TEST(PersistentBitArrayTest, HeldSnapshotSurvivesPublishes) {
+    BitArraySnapshots snapshots(PersistentBitArray(1000).set(1));
+    BitArraySnapshots::Snapshot held = snapshots.load();
+    for (int i = 2; i < 50; ++i) snapshots.publish(snapshots.load()->set(i));
+
+    EXPECT_EQ(held->count(), 1);
+    EXPECT_EQ(snapshots.load()->count(), 49);
+    held = snapshots.load();
+    snapshots.publish(PersistentBitArray(1000));
+    EXPECT_EQ(held->count(), 49);
+    EXPECT_TRUE((*snapshots.load()).none());
+}